@@ -0,0 +1,238 @@
+/*
+    TOPIC: Completely Fair Scheduler (CFS) - Proportional-Share CPU Scheduling
+
+    WHAT IS CFS?
+    - CFS is the Linux scheduler. Instead of fixed priorities it tries to give every runnable
+      task its fair share of the CPU, in proportion to the task's weight.
+    - The weight comes from the task's nice level (-20 = most CPU ... 19 = least CPU). Each nice
+      step is about 10% more or less CPU; nice 0 has weight 1024 (Linux's table below).
+    - Every task has a virtual runtime (vruntime): CPU time used, scaled by 1024 / weight.
+      Heavy tasks' vruntime grows slowly, light tasks' grows fast.
+    - The scheduler always runs the task with the smallest vruntime (the one that is furthest
+      behind its fair share), for a time slice, then picks again.
+
+    TIME SLICES
+    - Target latency L: every runnable task should run once within L time units.
+    - With nr tasks the scheduling period is L, or nr * G when nr * G > L (G = minimum
+      granularity, so slices never get too small).
+    - A task's slice is its weighted part of the period: period * weight / total weight (at least G).
+    - A new task starts with the smallest vruntime in the system (min_vruntime), so it neither
+      waits for the others to catch up nor monopolizes the CPU.
+    - Arrivals do not preempt: a new task waits at most for the running slice to end.
+
+    WHAT DOES THIS PROGRAM DO?
+    - Reads n tasks with Arrival Time (AT), Burst Time (BT) and nice level,
+      or reads them from a trace file (cfs --trace FILE [--latency L] [--min-gran G]), whose
+      PR column is used as the nice level (all nice 0 without one; see proc_trace.h).
+    - Simulates CFS and prints Completion Time (CT), Turn-Around Time (TAT), Waiting Time (WT)
+      and the fairness of every task, plus the averages.
+    - --stats also prints waiting, turn-around and response time percentiles, context switches
+      and preemptions; --timeline FILE saves the Gantt chart (see sched_probe.h).
+
+    FAIRNESS METRICS
+    - IDEAL: CPU time the task would have received from a perfectly fair CPU over its lifetime,
+      sharing every moment in proportion to the weights of the tasks runnable at that moment.
+    - ERR%: CPU share error = (BT - IDEAL) / TAT * 100, i.e. actual share of the CPU minus fair
+      share over the task's lifetime, in percentage points (positive = got more than its share).
+    - Max Lag: the largest gap, at any moment, between a task's fair share so far and what it
+      actually got. CFS keeps this around one time slice.
+
+    HOW IS IT FAST?
+    - Runnable tasks sit in a balanced binary search tree (std::set, a red-black tree like the
+      one Linux uses) ordered by (vruntime, index): picking and re-inserting are O(log n).
+    - The simulation jumps from event to event (arrival, slice end, completion).
+    - The fair share is tracked with one global counter V = integral of dt / (total weight),
+      so a task's ideal service is weight * (V now - V at arrival), in O(1) per task.
+*/
+
+#include <iostream>     // For cin, cout, cerr
+#include <vector>       // For vector (process table of any size)
+#include <set>          // For set (red-black tree of runnable tasks)
+#include <algorithm>    // For stable_sort, min, max
+#include <numeric>      // For iota
+#include <cmath>        // For fabs
+#include <climits>      // For LLONG_MAX
+#include <cstdlib>      // For atoll
+#include "proc_trace.h" // For ProcessTable, loadTrace(), argValue()
+#include "sched_probe.h" // For SchedProbe (--stats, --timeline)
+using namespace std;    // Avoid writing std:: repeatedly
+
+// Weight of each nice level, -20 to 19 (Linux's sched_prio_to_weight table)
+const long long NICE_TO_WEIGHT[40] = {
+    88761, 71755, 56483, 46273, 36291,   // -20 .. -16
+    29154, 23254, 18705, 14949, 11916,   // -15 .. -11
+     9548,  7620,  6100,  4904,  3906,   // -10 .. -6
+     3121,  2501,  1991,  1586,  1277,   //  -5 .. -1
+     1024,   820,   655,   526,   423,   //   0 .. 4
+      335,   272,   215,   172,   137,   //   5 .. 9
+      110,    87,    70,    56,    45,   //  10 .. 14
+       36,    29,    23,    18,    15,   //  15 .. 19
+};
+const long long NICE_0_WEIGHT = 1024;
+
+// CFS: fills ct[], ideal[] (fair CPU time over each task's lifetime) and maxLag[]
+template <class Probe = NullProbe>
+void cfs(const vector<long long> &art, const vector<long long> &bt, const vector<long long> &nice,
+         long long latency, long long minGran,
+         vector<long long> &ct, vector<double> &ideal, vector<double> &maxLag, Probe &&probe = Probe())
+{
+    int n = art.size();                     // number of tasks
+
+    vector<int> order(n);                   // task indices sorted by arrival time
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](int a, int b) { return art[a] < art[b]; });
+
+    vector<long long> weight(n), rem(bt), got(n, 0); // weight, remaining and received CPU time
+    for (int i = 0; i < n; i++)
+        weight[i] = NICE_TO_WEIGHT[min(19LL, max(-20LL, nice[i])) + 20];
+    vector<double> vruntime(n), vStart(n);  // virtual runtime; V when the task arrived
+
+    set<pair<double, int>> tree;            // runnable tasks (not running) by (vruntime, index)
+    long long totalWeight = 0;              // weight of all runnable tasks, the running one included
+    double minVruntime = 0;                 // never decreases; new tasks start here
+    double V = 0;                           // fair service per unit of weight so far
+
+    auto lagCheck = [&](int i) {            // lag is at an extreme when a task starts or stops
+        double lag = got[i] - weight[i] * (V - vStart[i]);
+        maxLag[i] = max(maxLag[i], fabs(lag));
+    };
+
+    long long time = 0;                     // current time
+    int next = 0;                           // position in order[] of the next task to arrive
+    int cur = -1;                           // running task (-1 = CPU idle)
+    long long sliceEnd = 0;                 // end of the running task's slice (or its completion)
+
+    for (int done = 0; done < n; ) {
+        if (cur == -1 && tree.empty())      // CPU idle: jump to the next arrival
+            time = max(time, art[order[next]]);
+
+        // Advance to the next event: slice end / completion or arrival
+        long long t = cur != -1 ? sliceEnd : LLONG_MAX;
+        if (next < n) t = min(t, art[order[next]]);
+        t = max(t, time);
+        if (totalWeight > 0) V += double(t - time) / totalWeight;
+        if (cur != -1) {                    // the running task used the CPU until t
+            rem[cur] -= t - time;
+            got[cur] += t - time;
+            probe.run(0, cur, time, t, rem[cur] == 0);
+            vruntime[cur] += double(t - time) * NICE_0_WEIGHT / weight[cur];
+            double m = vruntime[cur];       // min_vruntime follows the smallest vruntime
+            if (!tree.empty()) m = min(m, tree.begin()->first);
+            minVruntime = max(minVruntime, m);
+        }
+        time = t;
+
+        // Arrivals become runnable at min_vruntime
+        while (next < n && art[order[next]] <= time) {
+            int i = order[next++];
+            vruntime[i] = minVruntime;
+            vStart[i] = V;
+            tree.insert({vruntime[i], i});
+            totalWeight += weight[i];
+        }
+
+        // The running task finishes or its slice ends
+        if (cur != -1 && (rem[cur] == 0 || time == sliceEnd)) {
+            lagCheck(cur);
+            if (rem[cur] == 0) {
+                ct[cur] = time;             // finished: record completion time
+                ideal[cur] = weight[cur] * (V - vStart[cur]);
+                totalWeight -= weight[cur];
+                done++;
+            } else {
+                tree.insert({vruntime[cur], cur}); // back into the tree by its new vruntime
+            }
+            cur = -1;
+        }
+
+        // Pick the task with the smallest vruntime and give it its weighted slice
+        if (cur == -1 && !tree.empty()) {
+            cur = tree.begin()->second;
+            tree.erase(tree.begin());
+            minVruntime = max(minVruntime, vruntime[cur]);
+            lagCheck(cur);
+
+            long long nr = tree.size() + 1; // runnable tasks
+            long long period = nr * minGran > latency ? nr * minGran : latency;
+            long long slice = max(minGran, (long long)((double)period * weight[cur] / totalWeight));
+            sliceEnd = time + min(slice, rem[cur]);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    ios::sync_with_stdio(false);            // faster cin/cout for large inputs
+
+    long long latency = 24, minGran = 3;    // target latency and minimum granularity
+    ProcessTable pt;                        // process table: pt.art, pt.bt, pt.pr (= nice) columns
+    const char *trace = argValue(argc, argv, "--trace");
+    if (trace) {                            // batch mode: every task comes from the trace file
+        if (const char *l = argValue(argc, argv, "--latency")) latency = atoll(l);
+        if (const char *g = argValue(argc, argv, "--min-gran")) minGran = atoll(g);
+        if (!loadTrace(trace, pt)) return 1;
+        if (!pt.hasPriority()) pt.pr.assign(pt.size(), 0); // no PR column: everybody nice 0
+    } else {
+        int n;                              // number of tasks
+        cout << "Enter number of processes : ";
+        cin >> n;
+        pt.art.resize(n);
+        pt.bt.resize(n);
+        pt.pr.resize(n);
+
+        cout << "Enter Target Latency : ";
+        cin >> latency;
+        cout << "Enter Minimum Granularity : ";
+        cin >> minGran;
+
+        for (int i = 0; i < n; i++) {       // arrival time, burst time and nice level of each task
+            cout << "P" << i + 1 << " AT BT Nice(-20..19) : ";
+            cin >> pt.art[i] >> pt.bt[i] >> pt.pr[i];
+        }
+    }
+    if (latency <= 0 || minGran <= 0) {
+        cerr << "target latency and minimum granularity must be positive\n";
+        return 1;
+    }
+
+    int n = pt.size();                      // number of tasks
+    const vector<long long> &art = pt.art, &bt = pt.bt, &nice = pt.pr; // short column names
+    vector<long long> ct(n), tat(n), wt(n); // completion, turn-around and waiting times
+    vector<double> ideal(n), maxLag(n, 0);  // fair CPU time, largest lag of each task
+
+    const char *timeline = argValue(argc, argv, "--timeline"); // binary Gantt chart (sched_probe.h)
+    bool stats = argFlag(argc, argv, "--stats");              // print latency percentiles too
+    SchedProbe probe(stats || timeline ? n : 0, 1, timeline); // sees every run when enabled
+    if (!probe.ok()) return 1;
+
+    if (stats || timeline) cfs(art, bt, nice, latency, minGran, ct, ideal, maxLag, probe);
+    else cfs(art, bt, nice, latency, minGran, ct, ideal, maxLag); // run the simulation
+
+    double total_wt = 0, total_tat = 0;     // totals for averages
+    double total_err = 0, worst_err = 0, worst_lag = 0; // fairness summary
+    cout << "\nPID\tAT\tBT\tNICE\tCT\tTAT\tWT\tIDEAL\tERR%\n";
+    for (int i = 0; i < n; i++) {
+        tat[i] = ct[i] - art[i];            // TAT = CT - AT
+        wt[i] = tat[i] - bt[i];             // WT = TAT - BT
+        double err = tat[i] > 0 ? 100.0 * (bt[i] - ideal[i]) / tat[i] : 0; // share error
+        total_wt += wt[i];
+        total_tat += tat[i];
+        total_err += fabs(err);
+        worst_err = max(worst_err, fabs(err));
+        worst_lag = max(worst_lag, maxLag[i]);
+        cout << "P" << i + 1 << "\t" << art[i] << "\t" << bt[i] << "\t" << nice[i] << "\t"
+             << ct[i] << "\t" << tat[i] << "\t" << wt[i] << "\t" << ideal[i] << "\t" << err << "\n";
+    }
+
+    cout << "\nAverage Waiting Time     : " << total_wt / n << endl;
+    cout << "Average Turn-Around Time : " << total_tat / n << endl;
+    cout << "Average |Share Error| %  : " << total_err / n << endl;
+    cout << "Max |Share Error| %      : " << worst_err << endl;
+    cout << "Max Lag                  : " << worst_lag << endl;
+    if (stats) {                            // latency percentiles, context switches, preemptions
+        probe.finish(art, bt, ct);
+        probe.report(cout);
+    }
+
+    return 0;                               // successful termination
+}
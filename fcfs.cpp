@@ -7,63 +7,125 @@
     - Simple to implement but can suffer from the "convoy effect" (long jobs delay short ones).
 
     WHAT DOES THIS PROGRAM DO?
-    - Reads number of processes and for each process reads Arrival Time (AT) and Burst Time (BT).
+    - Reads number of processes and for each process reads Arrival Time (AT) and Burst Time (BT),
+      or reads them all from a trace file (fcfs --trace FILE, see proc_trace.h).
     - Sorts processes by arrival time.
     - Simulates FCFS to compute Completion Time (CT), Turn-Around Time (TAT), and Waiting Time (WT).
     - Prints per-process times and average WT and TAT.
+    - --stats also prints waiting, turn-around and response time percentiles, context switches
+      and preemptions; --timeline FILE saves the Gantt chart (see sched_probe.h).
+
+    SORTING BY ARRIVAL
+    - Arrival times are integers, so they are sorted without comparisons in O(n):
+      counting sort when they lie in a small range, otherwise radix sort 16 bits at a time
+      (arrivalOrder() in sched_engines.h).
+
+    STREAMING MODE (fcfs --stream FILE, or "-" for standard input)
+    - For a log that is already in arrival order, nothing needs to be stored:
+      each process's CT, TAT and WT depend only on the previous completion time.
+    - Each row is printed as soon as it is read and the averages are kept as running sums,
+      so memory stays constant and the log can be far larger than RAM.
 */
 
-#include <iostream>     // For cout, cin
-using namespace std;    // Use the standard namespace to avoid prefixing std::
+#include <iostream>         // For cout, cin
+#include <vector>           // For vector (process table of any size)
+#include <climits>          // For LLONG_MIN
+#include "proc_trace.h"     // For ProcessTable, loadTrace(), TraceReader
+#include "sched_engines.h"  // For arrivalOrder(), fcfs()
+using namespace std;        // Use the standard namespace to avoid prefixing std::
 
-int main()
+// Streaming FCFS over a trace already in arrival order, in constant memory
+int streamFCFS(const char *path)
 {
-    int n;                                 // n = number of processes
-    cout << "Enter number of processes: "; // Prompt user for number of processes
-    cin >> n;                              // Read number of processes into n
-
-    int pid[100], art[100], bt[100];       // Arrays: pid = process id, art = arrival times, bt = burst times
-    int ct[100], tat[100], wt[100];        // Arrays: ct = completion times, tat = turnaround times, wt = waiting times
-
-    cout << "Enter Arrival Time & Burst Time for each process:\n"; // Prompt for process info
-    for (int i = 0; i < n; i++) {          // Loop to read AT and BT for each process
-        pid[i] = i + 1;                    // Assign process id (P1, P2, ...)
-        cout << "P" << pid[i] << " AT: ";  // Prompt for Arrival Time of process i
-        cin >> art[i];                     // Read Arrival Time into art[i]
-        cout << "P" << pid[i] << " BT: ";  // Prompt for Burst Time of process i
-        cin >> bt[i];                      // Read Burst Time into bt[i]
+    TraceReader in(path);                  // Reads one process at a time
+    if (in.failed) return 1;
+
+    long long at, bt, pr;                  // Current process: arrival time, burst time (priority unused)
+    long long currtime = 0;                // Current time on CPU timeline
+    long long prevAt = LLONG_MIN;          // Arrival time of the previous process
+    long long n = 0;                       // Processes seen so far
+    double total_wt = 0, total_tat = 0;    // Running totals for the averages
+
+    cout << "\nPID\tAT\tBT\tCT\tTAT\tWT\n"; // Header for table output
+    while (in.next(at, bt, pr)) {
+        if (at < prevAt) {                 // Streaming needs arrival order; a full load can sort
+            cerr << path << ":" << in.line << ": arrival times are not in order (use --trace to sort)\n";
+            return 1;
+        }
+        prevAt = at;
+        n++;
+
+        if (currtime < at) currtime = at;  // CPU idle until this process arrives
+        long long ct = currtime + bt;      // Completion time = start time + burst time
+        long long tat = ct - at;           // Turn-Around Time = Completion Time - Arrival Time
+        long long wt = tat - bt;           // Waiting Time = Turn-Around Time - Burst Time
+        currtime = ct;
+
+        total_wt += wt;                    // Update running totals
+        total_tat += tat;
+        cout << "P" << n << "\t" << at << "\t" << bt << "\t"
+             << ct << "\t" << tat << "\t" << wt << "\n";
     }
+    if (in.failed) return 1;
+    if (n == 0) { cerr << path << ": no processes\n"; return 1; }
+
+    cout << "\nAverage Waiting Time     : " << total_wt / n << endl;      // Print average waiting time
+    cout << "Average Turn-Around Time : " << total_tat / n << endl;      // Print average TAT
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    ios::sync_with_stdio(false);           // Faster cin/cout for large inputs
+
+    if (const char *stream = argValue(argc, argv, "--stream"))
+        return streamFCFS(stream);         // Streaming mode: nothing is stored
 
-    // Sort processes by Arrival Time (Bubble Sort)
-    for (int i = 0; i < n - 1; i++) {      // Outer loop for bubble sort passes
-        for (int j = 0; j < n - i - 1; j++) { // Inner loop to compare adjacent pairs
-            if (art[j] > art[j + 1]) {     // If arrival time of current > next, swap to order by AT
-                swap(art[j], art[j + 1]);  // Swap arrival times
-                swap(bt[j], bt[j + 1]);    // Swap corresponding burst times so rows stay aligned
-                swap(pid[j], pid[j + 1]);  // Swap process IDs to keep association correct
-            }
+    ProcessTable pt;                       // Process table: pt.art = arrival times, pt.bt = burst times
+    const char *trace = argValue(argc, argv, "--trace");
+    if (trace) {                           // Batch mode: every process comes from the trace file
+        if (!loadTrace(trace, pt)) return 1;
+    } else {
+        int n;                                 // n = number of processes
+        cout << "Enter number of processes: "; // Prompt user for number of processes
+        cin >> n;                              // Read number of processes into n
+        pt.art.resize(n);
+        pt.bt.resize(n);
+
+        cout << "Enter Arrival Time & Burst Time for each process:\n"; // Prompt for process info
+        for (int i = 0; i < n; i++) {          // Loop to read AT and BT for each process
+            cout << "P" << i + 1 << " AT: ";   // Prompt for Arrival Time of process i
+            cin >> pt.art[i];                  // Read Arrival Time into art[i]
+            cout << "P" << i + 1 << " BT: ";   // Prompt for Burst Time of process i
+            cin >> pt.bt[i];                   // Read Burst Time into bt[i]
         }
     }
 
-    int currtime = 0;                      // currtime keeps track of current time on CPU timeline
-    for (int i = 0; i < n; i++) {          // Loop through processes in order of arrival
-        if (currtime < art[i])             // If CPU is idle until this process arrives
-            currtime = art[i];             // Advance current time to the arrival time
+    int n = pt.size();                     // n = number of processes
+    const vector<long long> &art = pt.art, &bt = pt.bt; // Short names for the AT and BT columns
+    vector<long long> ct(n), tat(n), wt(n); // ct = completion times, tat = turnaround times, wt = waiting times
+
+    vector<int> order = arrivalOrder(art); // Order processes by Arrival Time
+    const char *timeline = argValue(argc, argv, "--timeline"); // binary Gantt chart (sched_probe.h)
+    bool stats = argFlag(argc, argv, "--stats");              // print latency percentiles too
+    SchedProbe probe(stats || timeline ? n : 0, 1, timeline); // sees every run when enabled
+    if (!probe.ok()) return 1;
+
+    if (stats || timeline) fcfs(order, art, bt, ct, probe);
+    else fcfs(order, art, bt, ct);         // Run them in that order, fills ct[]
 
-        ct[i] = currtime + bt[i];          // Completion time = start time (currtime) + burst time
+    for (int i = 0; i < n; i++) {
         tat[i] = ct[i] - art[i];           // Turn-Around Time = Completion Time - Arrival Time
         wt[i] = tat[i] - bt[i];            // Waiting Time = Turn-Around Time - Burst Time
-
-        currtime = ct[i];                  // Update current time to this process's completion time
     }
 
     cout << "\nPID\tAT\tBT\tCT\tTAT\tWT\n"; // Header for table output
-    for (int i = 0; i < n; i++) {          // Print computed values for each process
-        cout << "P" << pid[i] << "\t" << art[i] << "\t" << bt[i] << "\t"
-             << ct[i] << "\t" << tat[i] << "\t" << wt[i] << endl;
+    for (int i : order) {                  // Print computed values for each process, in arrival order
+        cout << "P" << i + 1 << "\t" << art[i] << "\t" << bt[i] << "\t"
+             << ct[i] << "\t" << tat[i] << "\t" << wt[i] << "\n";
     }
 
-    float total_wt = 0, total_tat = 0;     // Totals for averages
+    double total_wt = 0, total_tat = 0;    // Totals for averages
     for (int i = 0; i < n; i++) {          // Sum up WT and TAT
         total_wt += wt[i];
         total_tat += tat[i];
@@ -71,6 +133,10 @@ int main()
 
     cout << "\nAverage Waiting Time     : " << total_wt / n << endl;      // Print average waiting time
     cout << "Average Turn-Around Time : " << total_tat / n << endl;      // Print average TAT
+    if (stats) {                                 // latency percentiles, context switches, preemptions
+        probe.finish(art, bt, ct);
+        probe.report(cout);
+    }
 
     return 0;                              // Exit program successfully
 }
@@ -12,31 +12,46 @@
     - Turn-Around Time (TAT = CT)
     - Waiting Time (WT = TAT – BT)
     - Average WT and TAT
+
+    BATCH MODE
+    - fcfs_noat --trace FILE reads the burst times from a trace file (see proc_trace.h).
+      Only the BT column is used; any arrival times in the trace are ignored.
 */
 
-#include<iostream>       // For input-output operations
-using namespace std;    // Avoid writing std:: repeatedly
+#include<iostream>          // For input-output operations
+#include<vector>            // For vector (process table of any size)
+#include "proc_trace.h"     // For ProcessTable, loadTrace()
+using namespace std;        // Avoid writing std:: repeatedly
 
-int main()
+int main(int argc, char *argv[])
 {
-    int n;                                  // Number of processes
-    cout << "Enter number of processes : ";  // Prompt
-    cin >> n;                                // Read number of processes
+    ios::sync_with_stdio(false);            // Faster cin/cout for large inputs
 
-    int pid[100], bt[100];                  // pid = process IDs, bt = burst times
-    int ct[100], tat[100], wt[100] = {0};   // Arrays for completion, turnaround & waiting time
+    ProcessTable pt;                        // Process table: only pt.bt (burst times) is used
+    const char *trace = argValue(argc, argv, "--trace");
+    if (trace) {                            // Batch mode: burst times come from the trace file
+        if (!loadTrace(trace, pt)) return 1;
+    } else {
+        int n;                                  // Number of processes
+        cout << "Enter number of processes : ";  // Prompt
+        cin >> n;                                // Read number of processes
+        pt.bt.resize(n);
 
-    // Input Burst Times
-    cout << "Enter Burst Time for each process : " << endl;
-    for(int i = 0; i < n; i++){
-        pid[i] = i + 1;                     // Assign process IDs P1, P2, ...
-        cout << "P" << pid[i] << " BT: ";   // Prompt for burst time of each process
-        cin >> bt[i];                       // Read burst time
+        // Input Burst Times
+        cout << "Enter Burst Time for each process : " << endl;
+        for(int i = 0; i < n; i++){
+            cout << "P" << i + 1 << " BT: ";    // Prompt for burst time of each process
+            cin >> pt.bt[i];                    // Read burst time
+        }
     }
 
-    int time = 0;                           // Tracks current time in FCFS execution
-    float sumwt = 0;                        // For average waiting time
-    float sumtat = 0;                       // For average turnaround time
+    int n = pt.size();                      // Number of processes
+    const vector<long long> &bt = pt.bt;    // bt = burst times
+    vector<long long> ct(n), tat(n), wt(n); // Arrays for completion, turnaround & waiting time
+
+    long long time = 0;                     // Tracks current time in FCFS execution
+    double sumwt = 0;                       // For average waiting time
+    double sumtat = 0;                      // For average turnaround time
 
     // Calculate CT, TAT, WT for each process
     for(int i = 0; i < n; i++){
@@ -53,8 +68,8 @@ int main()
     // Display table
     cout << "\nPID\tBT\tCT\tTAT\tWT\n";
     for(int i = 0; i < n; i++){
-        cout << "P" << pid[i] << "\t" << bt[i] << "\t"
-             << ct[i] << "\t" << tat[i] << "\t" << wt[i] << endl;
+        cout << "P" << i + 1 << "\t" << bt[i] << "\t"
+             << ct[i] << "\t" << tat[i] << "\t" << wt[i] << "\n";
     }
 
     // Display averages
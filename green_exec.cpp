@@ -0,0 +1,348 @@
+/*
+    TOPIC: Green-Thread Executor - the scheduling policies applied to real running tasks
+
+    WHAT IS A GREEN THREAD?
+    - A thread managed in user space instead of by the kernel: it has its own stack and saved
+      registers (a ucontext), and switching to it is a swapcontext() call that never goes
+      through the kernel's scheduler.
+    - A few real (kernel) threads, the workers, each run one green thread at a time and pick
+      the next one from a shared ready queue, exactly like CPUs picking processes.
+
+    WHAT DOES THIS PROGRAM DO?
+    - Reads a trace (AT, BT[, PR], see proc_trace.h). Every process becomes a real task that
+      is released at time AT and does BT time units of actual computation (--unit sets how
+      many microseconds one time unit is; the work loop is calibrated at start-up).
+    - Runs the tasks on --workers worker threads under FCFS, SJF (BT is the declared job
+      length), non-preemptive priority, or Round Robin with quantum --tq.
+    - The ready queue is ordered by the same keys as the simulators (smpKey() in
+      sched_engines.h): arrival for FCFS, BT for SJF, PR for priority, queue order for RR,
+      ties to the lower index. A task preempted by RR goes to the back, behind the tasks that
+      arrived during its quantum, as in rrobin.cpp.
+    - Simulates the same trace with the engines (1 worker: fcfs, nonPreemptive, roundRobin;
+      more: smpSchedule() with work stealing and no preemption, the closest to one shared
+      queue) and prints the simulated and the measured waiting and turn-around times side
+      by side.
+    - --stats adds the measured latency percentiles, context switches and preemptions, and
+      --timeline FILE saves the real Gantt chart in microseconds (see sched_probe.h).
+
+    TIMER-DRIVEN PREEMPTION POINTS
+    - A green thread cannot be interrupted from outside, so tasks call preemptionPoint()
+      every few hundred loop iterations. It is one load of a flag: a ticker thread raises a
+      worker's flag when its running task's quantum has expired, and only then does the
+      task switch back to its worker (which puts it at the back of the queue).
+    - FCFS, SJF and priority are non-preemptive, so their flags are never raised.
+
+    USAGE
+        green_exec --trace FILE --policy fcfs|sjf|prio|rr [--tq Q] [--workers K]
+                   [--unit MICROSECONDS] [--stack KB] [--stats] [--timeline FILE]
+    - Defaults: 1 worker, 1 time unit = 1000 us (1 ms), 64 KB stack per task.
+    - Measured times are printed in time units. They include the real costs the simulators
+      leave out (context switches, queue locking, the OS scheduling the workers), so expect
+      small differences, larger with more workers than cores.
+*/
+
+#include <iostream>         // For cout, cerr
+#include <vector>           // For vector
+#include <set>              // For set (ready queue ordered by policy key)
+#include <functional>       // For function (task bodies)
+#include <thread>           // For thread (workers, ticker)
+#include <mutex>            // For mutex, unique_lock
+#include <condition_variable> // For condition_variable (idle workers wait for tasks)
+#include <atomic>           // For atomic (preemption flags, slice deadlines)
+#include <chrono>           // For steady_clock
+#include <cstring>          // For strcmp
+#include <cstdlib>          // For atoi, atoll, atof
+#include <climits>          // For LLONG_MAX
+#include <ucontext.h>       // For getcontext, makecontext, swapcontext
+#include "proc_trace.h"     // For ProcessTable, loadTrace(), argValue(), argFlag()
+#include "sched_engines.h"  // For the simulated reference and SmpPolicy
+#include "sched_probe.h"    // For SchedProbe (--stats, --timeline)
+using namespace std;        // Avoid writing std:: repeatedly
+
+typedef chrono::steady_clock Clock;
+
+struct Worker {
+    ucontext_t ctx;                         // the worker's own context (its scheduling loop)
+    atomic<bool> expire{false};             // raised by the ticker: switch back at the next point
+    atomic<long long> sliceEnd{LLONG_MAX};  // when the running task's quantum ends (ns)
+};
+
+struct Task {
+    function<void()> body;                  // the real work
+    long long release = 0;                  // when it is released (ns after the start)
+    long long estimate = 0, priority = 0;   // SJF and priority keys
+    ucontext_t ctx;                         // saved registers while it is not running
+    vector<char> stack;                     // allocated at its first run, freed when it ends
+    Worker *worker = nullptr;               // worker running it right now
+    bool started = false, done = false;
+    // Measurements (ns)
+    long long released = 0, finished = 0;   // actual release and completion times
+    long long queued = 0, waited = 0, ran = 0; // joined the queue at, time spent in it, on a CPU
+};
+
+thread_local Task *currentTask = nullptr;   // task running on this worker thread
+
+// Runs tasks on worker threads under one scheduling policy
+class GreenExecutor {
+public:
+    GreenExecutor(SmpPolicy policy, long long quantumNs, int workers, size_t stackBytes)
+        : policy(policy), quantum(quantumNs), workers(workers), stackBytes(stackBytes) {}
+
+    // Add a task before run(): released at releaseNs, with its SJF estimate and priority
+    int add(function<void()> body, long long releaseNs, long long estimate, long long priority) {
+        tasks.emplace_back();
+        Task &t = tasks.back();
+        t.body = body;
+        t.release = releaseNs;
+        t.estimate = estimate;
+        t.priority = priority;
+        return tasks.size() - 1;
+    }
+    const Task &task(int i) const { return tasks[i]; }
+
+    // Called by task bodies: give the CPU back if the quantum has expired
+    static void __attribute__((noinline)) preemptionPoint() {
+        Task *t = currentTask;
+        if (t && t->worker->expire.load(memory_order_relaxed))
+            swapcontext(&t->ctx, &t->worker->ctx);
+    }
+
+    // Run every task to completion; probe.run() sees each real run (in microseconds)
+    void run(SchedProbe &probe) {
+        int n = tasks.size();
+        vector<int> order(n);               // release order
+        iota(order.begin(), order.end(), 0);
+        stable_sort(order.begin(), order.end(), [&](int a, int b) { return tasks[a].release < tasks[b].release; });
+
+        start = Clock::now();
+        vector<Worker> ws(workers);
+        vector<thread> pool;
+        for (int w = 0; w < workers; w++)
+            pool.emplace_back([&, w]() { workerLoop(w, ws[w], probe); });
+
+        atomic<bool> stop(false);           // ticker (RR only): raise the flags of expired quanta
+        long long tick = max(50000LL, quantum / 10);
+        thread ticker([&]() {
+            while (policy == SMP_RR && !stop.load()) {
+                this_thread::sleep_for(chrono::nanoseconds(tick));
+                long long t = now();
+                for (Worker &w : ws)
+                    if (t >= w.sliceEnd.load(memory_order_relaxed)) w.expire.store(true, memory_order_relaxed);
+            }
+        });
+
+        for (int k = 0; k < n; ) {          // release the tasks at their arrival times
+            this_thread::sleep_until(start + chrono::nanoseconds(tasks[order[k]].release));
+            lock_guard<mutex> lk(m);
+            long long t = now();
+            for (; k < n && tasks[order[k]].release <= t; k++) enqueue(order[k], t, true);
+            cv.notify_all();
+        }
+
+        for (thread &t : pool) t.join();
+        stop = true;
+        ticker.join();
+    }
+
+private:
+    SmpPolicy policy;
+    long long quantum;                      // RR quantum (ns)
+    int workers;
+    size_t stackBytes;
+    vector<Task> tasks;
+    Clock::time_point start;
+    mutex m;                                // guards everything below, and the probe
+    condition_variable cv;
+    set<pair<long long, int>> ready;        // (policy key, task index)
+    long long seq = 0, finishedCount = 0;
+
+    long long now() const { return chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count(); }
+
+    void enqueue(int i, long long t, bool arrival) { // caller holds m
+        Task &k = tasks[i];
+        if (arrival) k.released = t;
+        k.queued = t;
+        long long key = smpKey(policy, k.release, k.estimate, k.estimate, k.priority, seq);
+        ready.insert(make_pair(key, i));
+    }
+
+    static void trampoline() {              // first code a task runs
+        Task *t = currentTask;
+        t->body();
+        t->done = true;
+        setcontext(&t->worker->ctx);        // back to whichever worker runs it now
+    }
+
+    void workerLoop(int id, Worker &w, SchedProbe &probe) {
+        unique_lock<mutex> lk(m);
+        while (true) {
+            cv.wait(lk, [&]() { return !ready.empty() || finishedCount == (long long)tasks.size(); });
+            if (ready.empty()) break;       // everything finished
+            int i = ready.begin()->second;
+            ready.erase(ready.begin());
+            Task &t = tasks[i];
+            long long begin = now();
+            t.waited += begin - t.queued;
+            lk.unlock();
+
+            if (!t.started) {               // first run: give it a stack and an entry point
+                t.stack.resize(stackBytes);
+                getcontext(&t.ctx);
+                t.ctx.uc_stack.ss_sp = t.stack.data();
+                t.ctx.uc_stack.ss_size = t.stack.size();
+                t.ctx.uc_link = nullptr;
+                makecontext(&t.ctx, trampoline, 0);
+                t.started = true;
+            }
+            t.worker = &w;
+            w.expire.store(false, memory_order_relaxed);
+            w.sliceEnd.store(policy == SMP_RR ? begin + quantum : LLONG_MAX, memory_order_relaxed);
+            currentTask = &t;
+            swapcontext(&w.ctx, &t.ctx);    // run it until it finishes or its quantum expires
+            currentTask = nullptr;
+            w.sliceEnd.store(LLONG_MAX, memory_order_relaxed);
+            long long end = now();
+            t.ran += end - begin;
+
+            lk.lock();
+            probe.run(id, i, begin / 1000, end / 1000, t.done); // counts switches and preemptions
+            if (t.done) {
+                t.finished = end;
+                vector<char>().swap(t.stack);
+                if (++finishedCount == (long long)tasks.size()) cv.notify_all();
+            } else {
+                enqueue(i, end, false);     // back of the queue, behind this quantum's arrivals
+                cv.notify_one();
+            }
+        }
+    }
+};
+
+// The real work: a fixed number of multiply-adds, with a preemption point every 256
+volatile unsigned long long workSink;
+void burn(long long iterations)
+{
+    unsigned long long x = 88172645463325252ULL;
+    for (long long i = 0; i < iterations; i++) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        if ((i & 255) == 0) GreenExecutor::preemptionPoint();
+    }
+    workSink = x;
+}
+
+// Work loop iterations per nanosecond on this machine
+double calibrate()
+{
+    long long iterations = 1 << 22;
+    double best = 0;
+    for (int round = 0; round < 5; round++) {  // keep the fastest of a few rounds
+        auto t0 = Clock::now();
+        burn(iterations);
+        double ns = chrono::duration<double, nano>(Clock::now() - t0).count();
+        best = max(best, iterations / ns);
+    }
+    return best;
+}
+
+int main(int argc, char *argv[])
+{
+    ios::sync_with_stdio(false);            // faster cout for large outputs
+
+    const char *usage = "usage: green_exec --trace FILE --policy fcfs|sjf|prio|rr [--tq Q] [--workers K]\n"
+                        "                  [--unit MICROSECONDS] [--stack KB] [--stats] [--timeline FILE]\n";
+    const char *trace = argValue(argc, argv, "--trace"), *pol = argValue(argc, argv, "--policy");
+    const char *tqs = argValue(argc, argv, "--tq"), *ws = argValue(argc, argv, "--workers");
+    const char *us = argValue(argc, argv, "--unit"), *st = argValue(argc, argv, "--stack");
+    SmpPolicy policy = SMP_FCFS;
+    bool ok = trace && pol;
+    if (ok) {
+        if (strcmp(pol, "fcfs") == 0) policy = SMP_FCFS;
+        else if (strcmp(pol, "sjf") == 0) policy = SMP_SJF;
+        else if (strcmp(pol, "prio") == 0) policy = SMP_PRIO;
+        else if (strcmp(pol, "rr") == 0) policy = SMP_RR;
+        else ok = false;
+    }
+    long long tq = tqs ? atoll(tqs) : 0;
+    int workers = ws ? atoi(ws) : 1;
+    double unit = us ? atof(us) : 1000;     // microseconds per time unit
+    long long stackKb = st ? atoll(st) : 64;
+    if (!ok || (policy == SMP_RR && tq <= 0) || workers <= 0 || !(unit > 0) || stackKb < 16) {
+        cerr << usage;
+        return 1;
+    }
+
+    ProcessTable pt;
+    if (!loadTrace(trace, pt)) return 1;
+    if (policy == SMP_PRIO && !pt.hasPriority()) {
+        cerr << trace << ": trace has no priority column (needed by prio)\n";
+        return 1;
+    }
+    if (!pt.hasPriority()) pt.pr.assign(pt.size(), 0);
+    int n = pt.size();
+    const vector<long long> &art = pt.art, &bt = pt.bt, &pr = pt.pr; // short names for the columns
+    long long first = n ? *min_element(art.begin(), art.end()) : 0;
+
+    // Simulated reference
+    vector<long long> ct(n);
+    if (workers == 1) {
+        if (policy == SMP_FCFS) fcfs(arrivalOrder(art), art, bt, ct);
+        else if (policy == SMP_SJF) nonPreemptive(art, bt, bt, ct);
+        else if (policy == SMP_PRIO) nonPreemptive(art, bt, pr, ct);
+        else roundRobin(art, bt, tq, ct);
+    } else {
+        SmpConfig cfg;
+        cfg.cpus = workers;
+        cfg.policy = policy;
+        cfg.balance = BALANCE_STEAL;
+        cfg.tq = tq;
+        cfg.preempt = false;                // like the executor: a started task runs to its end
+        SmpStats stats;
+        smpSchedule(art, bt, pr, cfg, ct, stats);
+    }
+
+    // Real run
+    double perNs = calibrate();
+    double unitNs = unit * 1000;
+    GreenExecutor ex(policy, (long long)(tq * unitNs), workers, stackKb * 1024);
+    for (int i = 0; i < n; i++) {
+        long long iterations = (long long)(bt[i] * unitNs * perNs);
+        ex.add([iterations]() { burn(iterations); }, (long long)((art[i] - first) * unitNs), bt[i], pr[i]);
+    }
+    const char *timeline = argValue(argc, argv, "--timeline"); // real Gantt chart (sched_probe.h)
+    bool stats = argFlag(argc, argv, "--stats");              // print latency percentiles too
+    SchedProbe probe(n, workers, timeline); // always on: the run is real time anyway
+    if (!probe.ok()) return 1;
+    ex.run(probe);
+
+    // Side by side, in time units
+    double simWt = 0, simTat = 0, realWt = 0, realTat = 0;
+    cout << "\nPID\tAT\tBT\tWT\tTAT\tREAL_WT\tREAL_TAT\tREAL_CPU\n";
+    cout.setf(ios::fixed);
+    cout.precision(2);
+    for (int i = 0; i < n; i++) {
+        const Task &t = ex.task(i);
+        long long tat = ct[i] - art[i], wt = tat - bt[i];
+        double rwt = t.waited / unitNs, rtat = (t.finished - t.released) / unitNs;
+        simWt += wt; simTat += tat; realWt += rwt; realTat += rtat;
+        cout << "P" << i + 1 << "\t" << art[i] << "\t" << bt[i] << "\t" << wt << "\t" << tat << "\t"
+             << rwt << "\t" << rtat << "\t\t" << t.ran / unitNs << "\n";
+    }
+    cout << "\n\t\t\t Simulated\tMeasured\n";
+    cout << "Average Waiting Time     : " << simWt / n << "\t\t" << realWt / n << "\n";
+    cout << "Average Turn-Around Time : " << simTat / n << "\t\t" << realTat / n << "\n";
+    if (!stats) {
+        cout << "\nContext Switches         : " << probe.contextSwitches << "\n";
+        cout << "Preemptions              : " << probe.preemptions << "\n";
+    } else {                            // measured percentiles, in microseconds
+        vector<long long> a(n), b(n), c(n); // real release, CPU time and completion (us)
+        for (int i = 0; i < n; i++) {
+            a[i] = ex.task(i).released / 1000;
+            b[i] = ex.task(i).ran / 1000;
+            c[i] = ex.task(i).finished / 1000;
+        }
+        probe.finish(a, b, c);
+        cout << "\nMeasured latencies in microseconds:";
+        probe.report(cout);
+    }
+    return 0;                               // successful termination
+}
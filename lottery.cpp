@@ -0,0 +1,217 @@
+/*
+    TOPIC: Lottery Scheduling (Proportional-Share CPU Scheduling)
+
+    WHAT IS LOTTERY SCHEDULING?
+    - Every process holds some lottery tickets. At the start of each time quantum the
+      scheduler draws a random ticket among the ready processes, and its owner runs.
+    - A process holding 30% of the tickets wins about 30% of the quanta, so tickets express
+      each process's share of the CPU. Nobody starves: every ticket can win.
+    - The result is random, but fair on average (see stride.cpp for a deterministic version).
+
+    WHAT DOES THIS PROGRAM DO?
+    - Reads n processes with Arrival Time (AT), Burst Time (BT) and tickets (the priority
+      input of priority.cpp; here more tickets = more CPU), the time quantum and a seed,
+      or reads them from a trace file: lottery --trace FILE --tq Q [--seed S]
+      (the trace's PR column holds the tickets, see proc_trace.h).
+    - A running process keeps the CPU for a whole quantum (or until it finishes);
+      processes that arrive meanwhile join the next draw.
+    - Prints Completion Time (CT), Turn-Around Time (TAT) and Waiting Time (WT) per process,
+      and the averages.
+    - --stats also prints waiting, turn-around and response time percentiles, context switches
+      and preemptions; --timeline FILE saves the Gantt chart (see sched_probe.h).
+
+    REPRODUCIBLE RANDOMNESS
+    - Draws come from std::mt19937_64 seeded with --seed (default 1). Its output is fixed by
+      the C++ standard, and draws are reduced to a range by rejection sampling rather than
+      std::uniform_int_distribution (whose algorithm differs between libraries), so the same
+      seed gives the same schedule with every compiler.
+
+    HOW IS IT FAST?
+    - Ticket counts are kept in a Fenwick (binary indexed) tree indexed by process. Drawing
+      ticket r means finding the first process whose running ticket total passes r: one walk
+      down the tree, O(log n), instead of a linear scan over every ready process.
+    - When only one process is ready there is nothing to draw: it runs until the quantum in
+      which the next process arrives (or until it finishes) in one step.
+*/
+
+#include <iostream>     // For cin, cout, cerr
+#include <vector>       // For vector (process table of any size)
+#include <algorithm>    // For stable_sort, min, max
+#include <numeric>      // For iota
+#include <random>       // For mt19937_64
+#include <climits>      // For LLONG_MAX
+#include <cstdlib>      // For atoll, strtoull
+#include "proc_trace.h" // For ProcessTable, loadTrace(), argValue()
+#include "sched_probe.h" // For SchedProbe (--stats, --timeline)
+using namespace std;    // Avoid writing std:: repeatedly
+
+// Fenwick tree over the ticket counts of processes 0..n-1
+class TicketTree {
+public:
+    long long total = 0;                    // tickets of all ready processes
+
+    TicketTree(int n) : t(n + 1, 0) {
+        for (top = 1; top * 2 <= n; top *= 2) {}
+    }
+
+    void add(int i, long long d) {          // process i gains d tickets (d < 0: loses them)
+        total += d;
+        for (i++; i < (int)t.size(); i += i & -i) t[i] += d;
+    }
+    int pick(long long r) {                 // owner of ticket r (0 <= r < total)
+        int pos = 0;                        // walk down: largest pos with prefix(pos) <= r
+        for (int step = top; step > 0; step /= 2)
+            if (pos + step < (int)t.size() && t[pos + step] <= r) {
+                pos += step;
+                r -= t[pos];
+            }
+        return pos;                         // tree slot pos + 1, i.e. process index pos
+    }
+
+private:
+    vector<long long> t;                    // t[i]: tickets of processes (i - lowbit(i), i]
+    int top;                                // highest power of two <= n
+};
+
+// Uniform random number in [0, range), the same on every platform
+unsigned long long draw(mt19937_64 &rng, unsigned long long range)
+{
+    unsigned long long limit = ~0ULL - (~0ULL % range + 1) % range; // largest multiple of range, minus 1
+    unsigned long long x;
+    do x = rng(); while (x > limit);        // reject the few values that would bias the result
+    return x % range;
+}
+
+// Lottery scheduling: fills ct[] given arrival times, burst times, tickets, the quantum and a seed
+template <class Probe = NullProbe>
+void lottery(const vector<long long> &art, const vector<long long> &bt, const vector<long long> &tickets,
+             long long tq, unsigned long long seed, vector<long long> &ct, long long &draws,
+             Probe &&probe = Probe())
+{
+    int n = art.size();                     // number of processes
+
+    vector<int> order(n);                   // process indices sorted by arrival time
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](int a, int b) { return art[a] < art[b]; });
+
+    mt19937_64 rng(seed);                   // seeded: same draws on every run
+    TicketTree tree(n);                     // tickets of the ready processes
+    vector<long long> rem(bt);              // remaining burst time
+    long long time = 0;                     // current time
+    int next = 0, ready = 0;                // next arrival in order[], number of ready processes
+    draws = 0;
+
+    for (int done = 0; done < n; ) {
+        if (ready == 0)                     // CPU idle: jump to the next arrival
+            time = max(time, art[order[next]]);
+        while (next < n && art[order[next]] <= time) {
+            int i = order[next++];          // admit every process that has arrived by now
+            tree.add(i, tickets[i]);
+            ready++;
+        }
+
+        int w;                              // winner of this draw
+        long long slice;                    // how long it runs
+        if (ready == 1) {                   // a single ready process wins every draw until the
+            w = tree.pick(0);               // quantum in which the next process arrives
+            long long quanta = next < n ? max(1LL, (art[order[next]] - time + tq - 1) / tq) : LLONG_MAX / tq;
+            slice = min(rem[w], quanta * tq);
+        } else {
+            w = tree.pick(draw(rng, tree.total));
+            draws++;
+            slice = min(rem[w], tq);        // one quantum, or less if it finishes
+        }
+
+        probe.run(0, w, time, time + slice, rem[w] == slice);
+        time += slice;
+        rem[w] -= slice;
+        if (rem[w] == 0) {                  // finished: its tickets leave the lottery
+            ct[w] = time;
+            tree.add(w, -tickets[w]);
+            ready--;
+            done++;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    ios::sync_with_stdio(false);            // faster cin/cout for large inputs
+
+    long long tq;                           // time quantum
+    unsigned long long seed = 1;            // random seed
+    if (const char *s = argValue(argc, argv, "--seed")) seed = strtoull(s, nullptr, 10);
+
+    ProcessTable pt;                        // process table: pt.art, pt.bt, pt.pr (= tickets) columns
+    const char *trace = argValue(argc, argv, "--trace");
+    if (trace) {                            // batch mode: every process comes from the trace file
+        const char *q = argValue(argc, argv, "--tq");
+        if (!q || atoll(q) <= 0) {
+            cerr << "usage: lottery --trace FILE --tq QUANTUM [--seed S] [--stats] [--timeline FILE]\n";
+            return 1;
+        }
+        tq = atoll(q);
+        if (!loadTrace(trace, pt)) return 1;
+        if (!pt.hasPriority()) {
+            cerr << trace << ": trace has no priority (tickets) column\n";
+            return 1;
+        }
+    } else {
+        int n;                              // number of processes
+        cout << "Enter number of processes : ";
+        cin >> n;
+        pt.art.resize(n);
+        pt.bt.resize(n);
+        pt.pr.resize(n);
+
+        cout << "Enter Time Quantum : ";
+        cin >> tq;
+        cout << "Enter Random Seed : ";
+        cin >> seed;
+
+        for (int i = 0; i < n; i++) {       // arrival time, burst time and tickets of each process
+            cout << "P" << i + 1 << " AT BT Tickets : ";
+            cin >> pt.art[i] >> pt.bt[i] >> pt.pr[i];
+        }
+        if (tq <= 0) { cerr << "time quantum must be positive\n"; return 1; }
+    }
+
+    int n = pt.size();                      // number of processes
+    const vector<long long> &art = pt.art, &bt = pt.bt, &tickets = pt.pr; // short column names
+    for (int i = 0; i < n; i++)
+        if (tickets[i] <= 0) {
+            cerr << "P" << i + 1 << ": ticket count must be positive\n";
+            return 1;
+        }
+
+    vector<long long> ct(n), tat(n), wt(n); // completion, turn-around and waiting times
+    long long draws;                        // number of lottery draws
+    const char *timeline = argValue(argc, argv, "--timeline"); // binary Gantt chart (sched_probe.h)
+    bool stats = argFlag(argc, argv, "--stats");              // print latency percentiles too
+    SchedProbe probe(stats || timeline ? n : 0, 1, timeline); // sees every run when enabled
+    if (!probe.ok()) return 1;
+
+    if (stats || timeline) lottery(art, bt, tickets, tq, seed, ct, draws, probe);
+    else lottery(art, bt, tickets, tq, seed, ct, draws); // run the simulation, fills ct[]
+
+    double total_wt = 0, total_tat = 0;     // totals for averages
+    cout << "\nPID\tAT\tBT\tTICKETS\tCT\tTAT\tWT\n";
+    for (int i = 0; i < n; i++) {
+        tat[i] = ct[i] - art[i];            // TAT = CT - AT
+        wt[i] = tat[i] - bt[i];             // WT = TAT - BT
+        total_wt += wt[i];
+        total_tat += tat[i];
+        cout << "P" << i + 1 << "\t" << art[i] << "\t" << bt[i] << "\t" << tickets[i] << "\t"
+             << ct[i] << "\t" << tat[i] << "\t" << wt[i] << "\n";
+    }
+
+    cout << "\nAverage Waiting Time     : " << total_wt / n << endl;
+    cout << "Average Turn-Around Time : " << total_tat / n << endl;
+    cout << "Lottery Draws            : " << draws << endl;
+    if (stats) {                            // latency percentiles, context switches, preemptions
+        probe.finish(art, bt, ct);
+        probe.report(cout);
+    }
+
+    return 0;                               // successful termination
+}
@@ -0,0 +1,293 @@
+/*
+    TOPIC: Multilevel Feedback Queue (MLFQ) Scheduling
+
+    WHAT IS MLFQ?
+    - There are N ready queues (levels); level 0 has the highest priority.
+    - Within a level, processes take turns exactly as in Round Robin, with that level's
+      time quantum (lower levels usually get longer quanta).
+    - Between levels it works like preemptive priority scheduling: a process only runs when
+      every higher level is empty, and a process that becomes ready at a higher level
+      preempts the running one.
+    - Feedback rules:
+        1. A new process enters level 0.
+        2. A process that uses up its level's quantum moves down one level (demotion).
+           Time is counted across preemptions, so it cannot stay high by being preempted.
+        3. Every S time units all processes move back to level 0 (priority boost), so
+           long-running processes at the bottom cannot starve.
+      Short jobs finish in the top levels quickly; long CPU-bound jobs sink to the bottom.
+
+    WHAT DOES THIS PROGRAM DO?
+    - Reads the levels' quanta, the boost period and the processes' Arrival Time (AT) and
+      Burst Time (BT), or reads the processes from a trace file:
+          mlfq --trace FILE --quanta Q0,Q1,...,QN-1 [--boost S]
+      (see proc_trace.h; a boost period of 0 means no boosts).
+    - Simulates MLFQ and prints Completion Time (CT), Turn-Around Time (TAT) and
+      Waiting Time (WT) per process, the averages, and how many demotions and boosts happened.
+    - --stats also prints waiting, turn-around and response time percentiles, context switches
+      and preemptions; --timeline FILE saves the Gantt chart (see sched_probe.h).
+    - With a single level and no boosts this is exactly rrobin with TQ = Q0.
+
+    HOW IS IT FAST?
+    - Each level is a linked-list FIFO queue (O(1) push and pop), and a 64-bit bitmap marks the
+      non-empty levels, so the next process is found with one "lowest set bit" instruction,
+      no matter how many processes are waiting.
+    - A boost splices the level lists together in O(N); each process's level is reset lazily
+      the next time it is looked at (boost epochs), so a boost never touches every process.
+    - The simulation jumps from event to event (arrival, quantum end, completion, boost).
+*/
+
+#include <iostream>     // For cin, cout, cerr
+#include <vector>       // For vector (process table of any size)
+#include <algorithm>    // For stable_sort, min
+#include <numeric>      // For iota
+#include <climits>      // For LLONG_MAX
+#include <cstdint>      // For uint64_t (bitmap of non-empty levels)
+#include <cstdlib>      // For atoll, strtoll
+#include "proc_trace.h" // For ProcessTable, loadTrace(), argValue()
+#include "sched_probe.h" // For SchedProbe (--stats, --timeline)
+using namespace std;    // Avoid writing std:: repeatedly
+
+const int MAX_LEVELS = 64;      // one bit per level in the bitmap
+
+// The N ready queues: one linked list per level plus a bitmap of the non-empty levels
+class LevelQueues {
+public:
+    uint64_t nonEmpty = 0;      // bit l is set when level l has a waiting process
+
+    LevelQueues(int n, int levels) : nxt(n, -1), head(levels, -1), tail(levels, -1) {}
+
+    bool empty() const { return nonEmpty == 0; }
+    int topLevel() const { return __builtin_ctzll(nonEmpty); } // highest-priority non-empty level
+
+    void pushBack(int l, int i) {           // process i joins the back of level l
+        nxt[i] = -1;
+        if (head[l] == -1) { head[l] = i; nonEmpty |= 1ULL << l; }
+        else nxt[tail[l]] = i;
+        tail[l] = i;
+    }
+    int popFront(int l) {                   // take the process at the front of level l
+        int i = head[l];
+        head[l] = nxt[i];
+        if (head[l] == -1) nonEmpty &= ~(1ULL << l);
+        return i;
+    }
+    void mergeAllInto0() {                  // boost: append levels 1..N-1 behind level 0, in order
+        for (int l = 1; l < (int)head.size(); l++) {
+            if (head[l] == -1) continue;
+            if (head[0] == -1) head[0] = head[l];
+            else nxt[tail[0]] = head[l];
+            tail[0] = tail[l];
+            head[l] = tail[l] = -1;
+        }
+        nonEmpty = head[0] != -1;
+    }
+
+private:
+    vector<int> nxt;            // next process in the same level's queue
+    vector<int> head, tail;     // front and back of each level (-1 = empty)
+};
+
+// MLFQ: fills ct[] given arrival times, burst times, the quanta of the levels and the boost
+// period (0 = never). Counts demotions and boosts.
+template <class Probe = NullProbe>
+void mlfq(const vector<long long> &art, const vector<long long> &bt, const vector<long long> &quanta,
+          long long boost, vector<long long> &ct, long long &demotions, long long &boosts,
+          Probe &&probe = Probe())
+{
+    int n = art.size();                     // number of processes
+    int levels = quanta.size();             // number of queues
+
+    vector<int> order(n);                   // process indices sorted by arrival time
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](int a, int b) { return art[a] < art[b]; });
+
+    LevelQueues q(n, levels);
+    vector<long long> rem(bt);              // remaining burst time
+    vector<long long> used(n, 0);           // time used of the current level's quantum
+    vector<int> level(n, 0);                // current level of each process
+    vector<long long> epoch(n, 0);          // boost count when level[]/used[] were last valid
+    long long boostEpoch = 0;               // number of boosts so far
+
+    auto refresh = [&](int i) {             // apply any boost that happened since i was queued
+        if (epoch[i] != boostEpoch) { level[i] = 0; used[i] = 0; epoch[i] = boostEpoch; }
+    };
+
+    long long time = 0;                     // current time
+    long long nextBoost = boost > 0 ? boost : LLONG_MAX; // time of the next priority boost
+    int next = 0;                           // position in order[] of the next process to arrive
+    int cur = -1;                           // running process (-1 = CPU idle)
+    long long sliceEnd = 0;                 // when cur finishes or uses up its quantum
+    demotions = boosts = 0;
+
+    auto dispatch = [&]() {                 // run the front process of the highest non-empty level
+        int l = q.topLevel();
+        cur = q.popFront(l);
+        refresh(cur);
+        sliceEnd = time + min(rem[cur], quanta[level[cur]] - used[cur]);
+    };
+
+    for (int done = 0; done < n; ) {
+        if (cur == -1 && q.empty()) {       // CPU idle: jump to the next arrival
+            time = max(time, art[order[next]]);
+            if (nextBoost < time)            // boosts while the system was empty change nothing
+                nextBoost = (time / boost + 1) * boost;
+        }
+
+        // Advance to the next event: slice end, arrival or boost
+        long long t = cur != -1 ? sliceEnd : LLONG_MAX;
+        if (next < n) t = min(t, art[order[next]]);
+        t = max(time, min(t, nextBoost));
+        if (cur != -1) {                    // the running process uses the CPU until t
+            rem[cur] -= t - time;
+            used[cur] += t - time;
+            probe.run(0, cur, time, t, rem[cur] == 0);
+        }
+        time = t;
+
+        // 1) Arrivals join level 0 (before a preempted process is re-queued, as in rrobin)
+        while (next < n && art[order[next]] <= time) {
+            int i = order[next++];
+            if (rem[i] <= 0) {              // BT 0: finished on arrival, as in rrobin
+                ct[i] = time;
+                done++;
+                continue;
+            }
+            epoch[i] = boostEpoch;
+            q.pushBack(0, i);
+        }
+
+        // 2) The running process finishes or uses up its quantum
+        if (cur != -1 && rem[cur] == 0) {
+            ct[cur] = time;                 // finished: record completion time
+            done++;
+            cur = -1;
+        } else if (cur != -1 && used[cur] == quanta[level[cur]]) {
+            if (level[cur] + 1 < levels) { level[cur]++; demotions++; } // demote one level
+            used[cur] = 0;
+            q.pushBack(level[cur], cur);    // back of its (new) level
+            cur = -1;
+        }
+
+        // 3) Priority boost: everybody back to level 0
+        if (time == nextBoost) {
+            boostEpoch++;
+            boosts++;
+            q.mergeAllInto0();
+            if (cur != -1) {                // the running process starts a fresh level-0 quantum
+                level[cur] = 0; used[cur] = 0; epoch[cur] = boostEpoch;
+                sliceEnd = time + min(rem[cur], quanta[0]);
+            }
+            nextBoost += boost;
+        }
+
+        // 4) Dispatch, or preempt if a higher level has a waiting process
+        if (!q.empty()) {
+            if (cur == -1) dispatch();
+            else if (q.topLevel() < level[cur]) {
+                q.pushBack(level[cur], cur); // preempted: back of its level, keeps used[]
+                dispatch();
+            }
+        }
+    }
+}
+
+// Parse "Q0,Q1,..." into quanta; false if empty, too long or not all positive
+bool parseQuanta(const char *s, vector<long long> &quanta)
+{
+    quanta.clear();
+    while (*s) {
+        char *end;
+        long long v = strtoll(s, &end, 10);
+        if (end == s || v <= 0) return false;
+        quanta.push_back(v);
+        s = *end == ',' ? end + 1 : end;
+        if (*end && *end != ',') return false;
+    }
+    return !quanta.empty() && quanta.size() <= MAX_LEVELS;
+}
+
+int main(int argc, char *argv[])
+{
+    ios::sync_with_stdio(false);            // faster cin/cout for large inputs
+
+    vector<long long> quanta;               // time quantum of each level
+    long long boost = 0;                    // priority boost period (0 = never)
+    ProcessTable pt;                        // process table: pt.art = arrival times, pt.bt = burst times
+    const char *trace = argValue(argc, argv, "--trace");
+    if (trace) {                            // batch mode: every process comes from the trace file
+        const char *qs = argValue(argc, argv, "--quanta");
+        const char *b = argValue(argc, argv, "--boost");
+        if (!qs || !parseQuanta(qs, quanta) || (b && atoll(b) < 0)) {
+            cerr << "usage: mlfq --trace FILE --quanta Q0,Q1,... [--boost S] [--stats] [--timeline FILE]\n";
+            return 1;
+        }
+        if (b) boost = atoll(b);
+        if (!loadTrace(trace, pt)) return 1;
+    } else {
+        int n, levels;                      // number of processes and of levels
+        cout << "Enter number of processes: ";
+        cin >> n;
+        pt.art.resize(n);
+        pt.bt.resize(n);
+
+        cout << "Enter number of levels (1-" << MAX_LEVELS << "): ";
+        cin >> levels;
+        if (levels < 1 || levels > MAX_LEVELS) {
+            cerr << "number of levels must be 1 to " << MAX_LEVELS << "\n";
+            return 1;
+        }
+        quanta.resize(levels);
+        for (int l = 0; l < levels; l++) {  // quantum of each level, top level first
+            cout << "Enter Time Quantum of level " << l << ": ";
+            cin >> quanta[l];
+            if (quanta[l] <= 0) { cerr << "time quantum must be positive\n"; return 1; }
+        }
+        cout << "Enter Priority Boost period (0 = no boost): ";
+        cin >> boost;
+        if (boost < 0) boost = 0;
+
+        for (int i = 0; i < n; i++) {       // arrival and burst time of each process
+            cout << "Enter Arrival Time & Burst Time of P" << i + 1 << ": ";
+            cin >> pt.art[i] >> pt.bt[i];
+        }
+    }
+
+    int n = pt.size();                      // number of processes
+    const vector<long long> &art = pt.art, &bt = pt.bt; // short names for the AT and BT columns
+    vector<long long> ct(n), tat(n), wt(n); // completion, turn-around and waiting times
+    long long demotions, boosts;
+
+    const char *timeline = argValue(argc, argv, "--timeline"); // binary Gantt chart (sched_probe.h)
+    bool stats = argFlag(argc, argv, "--stats");              // print latency percentiles too
+    SchedProbe probe(stats || timeline ? n : 0, 1, timeline); // sees every run when enabled
+    if (!probe.ok()) return 1;
+
+    if (stats || timeline) mlfq(art, bt, quanta, boost, ct, demotions, boosts, probe);
+    else mlfq(art, bt, quanta, boost, ct, demotions, boosts); // run the simulation, fills ct[]
+
+    double total_wt = 0, total_tat = 0;     // totals for averages
+    for (int i = 0; i < n; i++) {
+        tat[i] = ct[i] - art[i];            // TAT = CT - AT
+        wt[i] = tat[i] - bt[i];             // WT = TAT - BT
+        total_wt += wt[i];
+        total_tat += tat[i];
+    }
+
+    // Display results in a table
+    cout << "\nPID\tAT\tBT\tCT\tTAT\tWT\n";
+    for (int i = 0; i < n; i++) {
+        cout << "P" << i + 1 << "\t" << art[i] << "\t" << bt[i] << "\t"
+             << ct[i] << "\t" << tat[i] << "\t" << wt[i] << "\n";
+    }
+
+    cout << "\nAverage Waiting Time     : " << total_wt / n << endl;
+    cout << "Average Turn-Around Time : " << total_tat / n << endl;
+    cout << "Demotions                : " << demotions << endl;
+    cout << "Priority Boosts          : " << boosts << endl;
+    if (stats) {                            // latency percentiles, context switches, preemptions
+        probe.finish(art, bt, ct);
+        probe.report(cout);
+    }
+
+    return 0;                               // successful termination
+}
@@ -0,0 +1,787 @@
+/*
+    TOPIC: Page Replacement Policies
+
+    WHAT IS THIS FILE?
+    - The replacement policies that page_replace.cpp simulates, one class each. A policy
+      models f frames, all empty at the start: access(page) references one page and returns
+      true on a page fault, faults() counts the faults so far.
+    - Every policy derives from PagePolicy<Policy> (CRTP): the base counts the faults and
+      drives whole reference strings, the policy only supplies reference(page). There are
+      no virtual functions, so the whole per-reference path inlines into the driving loop.
+    - All policies see the same references through the same interface, so their fault
+      counts are directly comparable.
+
+    POLICIES
+    - FifoPolicy    : evict the page that was loaded first.
+    - LruPolicy     : evict the page used least recently.
+    - OptimalPolicy : Belady: evict the page used farthest in the future (needs the whole
+                      reference string up front; the lower bound for every other policy).
+    - ClockPolicy   : second chance: a hand sweeps the frames, clearing reference bits,
+                      and evicts the first page whose bit is already clear.
+    - LfuPolicy     : evict the page used least often since it was loaded (ties: the least
+                      recently used of them).
+    - TwoQPolicy    : 2Q (Johnson & Shasha): a new page enters a FIFO A1in (1/4 of the frames);
+                      only a page referenced again after leaving it (remembered in the ghost
+                      list A1out, 1/2 of the frames' worth of page numbers) enters the LRU main
+                      queue Am, so a one-time scan cannot flush Am.
+    - ArcPolicy     : ARC (Megiddo & Modha): LRU lists of pages seen once (T1) and at least
+                      twice (T2), plus ghost lists of pages recently evicted from each (B1, B2).
+                      A fault on a ghost moves the target size of T1 towards the list that
+                      would have hit.
+    - LirsPolicy    : LIRS (Jiang & Zhang): ranks pages by reuse distance instead of recency.
+                      Pages with a short reuse distance (LIR, 99% of the frames) stay; the
+                      rest (HIR) rotate through a FIFO of the remaining 1%. The recency stack
+                      remembers at most 2 * frames evicted pages, so memory follows the frames.
+
+    HOW IS IT FAST?
+    - O(1) work per reference for every policy except Optimal (O(log f) per fault).
+    - Each policy finds its pages, resident and ghost, with a single PageIndex lookup (a hash
+      table with open addressing). Its lists are intrusive: links live in arrays indexed by
+      node, so references never allocate.
+    - LFU keeps the pages in buckets of equal use count, buckets in count order (Shah, Mitra
+      & Matani): a hit moves a page to the next bucket, a fault evicts from the first one.
+*/
+
+#ifndef PAGE_POLICIES_H
+#define PAGE_POLICIES_H
+
+#include <vector>       // std::vector
+#include <algorithm>    // std::push_heap, std::pop_heap, std::make_heap, std::min, std::max
+#include <utility>      // std::pair
+#include <memory>       // std::shared_ptr (next uses shared by Optimal runs)
+#include <climits>      // LLONG_MIN
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>  // AVX2 / SSE4.1 intrinsics (scanFrames())
+#endif
+
+// 64-bit mix of a page number (splitmix64): the hash behind PageIndex and page sampling
+inline unsigned long long pageHash(long long page)
+{
+    unsigned long long x = page + 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Hash index page -> value (a frame, a position in the trace, ...): open addressing with
+// linear probing, kept at most half full (it doubles when needed)
+template <class Value = int>
+class PageIndex {
+public:
+    void reset(size_t expected) {          // empty index sized for 'expected' pages
+        size_t cap = 16;
+        while (cap < 2 * expected) cap *= 2;
+        keys.assign(cap, EMPTY);
+        vals.assign(cap, -1);
+        mask = cap - 1;
+        count = 0;
+    }
+
+    Value find(long long page) const {     // value stored for page, -1 if none
+        for (size_t i = pageHash(page) & mask; ; i = (i + 1) & mask) {
+            if (keys[i] == page) return vals[i];
+            if (keys[i] == EMPTY) return -1;
+        }
+    }
+
+    void set(long long page, Value v) {    // insert page or replace its value
+        size_t i = pageHash(page) & mask;
+        while (keys[i] != EMPTY && keys[i] != page) i = (i + 1) & mask;
+        if (keys[i] == EMPTY) {
+            if (2 * (count + 1) > keys.size()) { grow(); set(page, v); return; }
+            keys[i] = page;
+            count++;
+        }
+        vals[i] = v;
+    }
+
+    void erase(long long page) {           // page must be in the index
+        size_t i = pageHash(page) & mask;
+        while (keys[i] != page) i = (i + 1) & mask;
+        // Backward shift: pull later entries of the probe run into the hole, so lookups never
+        // stop early at it and no "deleted" markers pile up
+        for (size_t j = i; ; ) {
+            j = (j + 1) & mask;
+            if (keys[j] == EMPTY) break;
+            size_t home = pageHash(keys[j]) & mask;
+            bool stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+            if (stays) continue;           // its home is after the hole: it must not move
+            keys[i] = keys[j];
+            vals[i] = vals[j];
+            i = j;
+        }
+        keys[i] = EMPTY;
+        count--;
+    }
+
+    size_t size() const { return count; }  // pages in the index
+
+private:
+    static constexpr long long EMPTY = LLONG_MIN;  // marks a free slot (not a valid page)
+    std::vector<long long> keys;           // page in each slot
+    std::vector<Value> vals;               // its value
+    size_t mask = 0;                       // capacity - 1 (capacity is a power of two)
+    size_t count = 0;                      // used slots
+
+    void grow() {                          // double the capacity and re-insert everything
+        std::vector<long long> oldKeys;
+        std::vector<Value> oldVals;
+        oldKeys.swap(keys);
+        oldVals.swap(vals);
+        reset(oldKeys.size());
+        for (size_t i = 0; i < oldKeys.size(); i++)
+            if (oldKeys[i] != EMPTY) set(oldKeys[i], oldVals[i]);
+    }
+};
+
+// Next use of every reference in one backward pass: result[i] is the position of the next
+// reference to the same page as ref[i], or ref.size() if that page is never used again
+inline std::vector<long long> nextUses(const std::vector<long long> &ref)
+{
+    long long n = ref.size();
+    std::vector<long long> nextUse(n);
+    PageIndex<long long> later;            // page -> its first position after i
+    later.reset(1024);                     // grows with the number of distinct pages
+    for (long long i = n - 1; i >= 0; i--) {
+        long long k = later.find(ref[i]);
+        nextUse[i] = k == -1 ? n : k;
+        later.set(ref[i], i);
+    }
+    return nextUse;
+}
+
+// ------------------------------------------
+// Frame table: which page is in which frame
+// ------------------------------------------
+// A small frame array is simply compared against the page: with AVX2, 4 frames per compare
+// instruction and 16 per loop iteration; with SSE4.1, 2 and 8; elsewhere one at a time. The
+// instruction set is chosen at run time, so no special compiler flags are needed. Up to
+// SCAN_FRAMES frames this beats hashing; larger tables use a PageIndex.
+const long long NO_PAGE = LLONG_MIN;       // page of an empty frame
+
+inline int scanFramesScalar(const long long *frame, int n, long long page)
+{
+    for (int i = 0; i < n; i++)
+        if (frame[i] == page) return i;
+    return -1;
+}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+__attribute__((target("avx2")))
+inline int scanFramesAvx2(const long long *frame, int n, long long page) // n: multiple of 16
+{
+    __m256i key = _mm256_set1_epi64x(page);
+    for (int i = 0; i < n; i += 16) {
+        const __m256i *p = (const __m256i *)(frame + i);
+        int m = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_loadu_si256(p), key)))
+              | _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_loadu_si256(p + 1), key))) << 4
+              | _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_loadu_si256(p + 2), key))) << 8
+              | _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_loadu_si256(p + 3), key))) << 12;
+        if (m) return i + __builtin_ctz(m);
+    }
+    return -1;
+}
+
+__attribute__((target("sse4.1")))
+inline int scanFramesSse(const long long *frame, int n, long long page) // n: multiple of 16
+{
+    __m128i key = _mm_set1_epi64x(page);
+    for (int i = 0; i < n; i += 8) {
+        const __m128i *p = (const __m128i *)(frame + i);
+        int m = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(_mm_loadu_si128(p), key)))
+              | _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(_mm_loadu_si128(p + 1), key))) << 2
+              | _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(_mm_loadu_si128(p + 2), key))) << 4
+              | _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(_mm_loadu_si128(p + 3), key))) << 6;
+        if (m) return i + __builtin_ctz(m);
+    }
+    return -1;
+}
+#endif
+
+// Frame holding page among frame[0 .. n-1] (n a multiple of 16), -1 if none
+inline int scanFrames(const long long *frame, int n, long long page)
+{
+#if defined(__x86_64__) && defined(__GNUC__)
+    static const int level = __builtin_cpu_supports("avx2") ? 2 : __builtin_cpu_supports("sse4.1") ? 1 : 0;
+    if (level == 2) return scanFramesAvx2(frame, n, page);
+    if (level == 1) return scanFramesSse(frame, n, page);
+#endif
+    return scanFramesScalar(frame, n, page);
+}
+
+class FrameTable {
+public:
+    static const int SCAN_FRAMES = 64;     // largest table that is scanned instead of hashed
+
+    explicit FrameTable(int frames)
+        : frame((frames + 15) / 16 * 16, NO_PAGE), hashed(frames > SCAN_FRAMES) {
+        if (hashed) where.reset(frames);
+    }
+
+    int find(long long page) const {       // frame holding page, -1 if none
+        return hashed ? where.find(page) : scanFrames(frame.data(), frame.size(), page);
+    }
+    long long operator[](int f) const { return frame[f]; }  // page in frame f, NO_PAGE = empty
+
+    void set(int f, long long page) {      // load page into frame f, replacing what was there
+        if (hashed) {
+            if (frame[f] != NO_PAGE) where.erase(frame[f]);
+            where.set(page, f);
+        }
+        frame[f] = page;
+    }
+
+private:
+    std::vector<long long> frame;          // page in each frame, padded to a multiple of 16
+    bool hashed;                           // large table: use the index
+    PageIndex<> where;                     // page -> frame (large tables only)
+};
+
+// Several doubly linked lists of pages over one node pool and one hash index, so a single
+// lookup tells whether a page is tracked and in which list. Front = most recent.
+class PageLists {
+public:
+    PageLists(int lists, size_t expected) : ends(lists) { index.reset(expected); }
+
+    int find(long long page) const { return index.find(page); }  // node of page, -1 if none
+    int listOf(int node) const { return nodes[node].list; }
+    long long pageOf(int node) const { return nodes[node].page; }
+    int size(int list) const { return ends[list].size; }
+    int back(int list) const { return ends[list].tail; }  // least recent node, -1 if empty
+
+    int pushFront(long long page, int list) {  // start tracking page; returns its node
+        int node;
+        if (!spare.empty()) { node = spare.back(); spare.pop_back(); }
+        else { node = nodes.size(); nodes.push_back(Node()); }
+        nodes[node].page = page;
+        index.set(page, node);
+        link(node, list);
+        return node;
+    }
+
+    void moveToFront(int node, int list) { unlink(node); link(node, list); }
+
+    void erase(int node) {                 // stop tracking the page
+        unlink(node);
+        index.erase(nodes[node].page);
+        spare.push_back(node);
+    }
+
+    long long popBack(int list) {          // erase the least recent page of the list
+        int node = ends[list].tail;
+        long long page = nodes[node].page;
+        erase(node);
+        return page;
+    }
+
+    void moveBack(int from, int to) { moveToFront(ends[from].tail, to); } // oldest of 'from' -> front of 'to'
+
+private:
+    struct Node { long long page; int list, prev, next; };
+    struct End { int head = -1, tail = -1, size = 0; };
+    std::vector<Node> nodes;               // node pool
+    std::vector<int> spare;                // free nodes
+    std::vector<End> ends;                 // head, tail and length of every list
+    PageIndex<> index;                     // page -> node
+
+    void link(int node, int list) {        // insert at the front of list
+        Node &x = nodes[node];
+        End &e = ends[list];
+        x.list = list;
+        x.prev = -1;
+        x.next = e.head;
+        if (e.head != -1) nodes[e.head].prev = node; else e.tail = node;
+        e.head = node;
+        e.size++;
+    }
+    void unlink(int node) {
+        Node &x = nodes[node];
+        End &e = ends[x.list];
+        if (x.prev != -1) nodes[x.prev].next = x.next; else e.head = x.next;
+        if (x.next != -1) nodes[x.next].prev = x.prev; else e.tail = x.prev;
+        e.size--;
+    }
+};
+
+// Base of every policy (CRTP): Policy supplies bool reference(long long page), true on a fault
+template <class Policy>
+class PagePolicy {
+public:
+    bool access(long long page) {          // reference one page; true on a page fault
+        bool fault = static_cast<Policy *>(this)->reference(page);
+        pageFaults += fault;
+        return fault;
+    }
+
+    template <class It>
+    void run(It first, It last) {          // reference every page in [first, last)
+        for (; first != last; ++first) access(*first);
+    }
+
+    long long faults() const { return pageFaults; }
+
+private:
+    long long pageFaults = 0;
+};
+
+// ------------------------------------------
+// FIFO: circular replacement over the frames
+// ------------------------------------------
+class FifoPolicy : public PagePolicy<FifoPolicy> {
+public:
+    static constexpr const char *NAME = "FIFO";
+
+    explicit FifoPolicy(int frames) : frames(frames), frame(frames) {}
+
+    bool reference(long long page) {
+        if (frame.find(page) != -1) return false;
+        frame.set(next, page);             // the oldest page leaves
+        next = next + 1 == frames ? 0 : next + 1;
+        return true;
+    }
+
+private:
+    int frames;
+    FrameTable frame;                      // page in each frame
+    int next = 0;                          // frame to replace next
+};
+
+// ------------------------------------------
+// LRU: one list in order of use
+// ------------------------------------------
+class LruPolicy : public PagePolicy<LruPolicy> {
+public:
+    static constexpr const char *NAME = "LRU";
+
+    explicit LruPolicy(int frames) : frames(frames), pages(1, frames) {}
+
+    bool reference(long long page) {
+        int node = pages.find(page);
+        if (node != -1) { pages.moveToFront(node, 0); return false; }
+        if (pages.size(0) == frames) pages.popBack(0);
+        pages.pushFront(page, 0);
+        return true;
+    }
+
+private:
+    int frames;
+    PageLists pages;                       // resident pages, most recently used first
+};
+
+// ------------------------------------------
+// Optimal (Belady): max-heap of the frames by next use
+// ------------------------------------------
+// reference() must be called with ref[0], ref[1], ... in order. A hit only pushes a new heap
+// entry; the old one can never reach the top, since stale entries hold positions <= the
+// current one and live entries later ones. The heap is rebuilt when it gets too large.
+class OptimalPolicy : public PagePolicy<OptimalPolicy> {
+public:
+    static constexpr const char *NAME = "Optimal";
+
+    OptimalPolicy(int frames, const std::vector<long long> &ref)
+        : OptimalPolicy(frames, std::make_shared<const std::vector<long long>>(nextUses(ref))) {}
+
+    // With the next uses from nextUses(), shared by any number of policies
+    OptimalPolicy(int frames, std::shared_ptr<const std::vector<long long>> nextUse)
+        : nextUse(nextUse), frames(frames), frame(frames), key(frames) {}
+
+    bool reference(long long page) {
+        int f = frame.find(page);
+        bool fault = f == -1;
+        if (fault) {
+            if (used < frames) {
+                f = used++;                // an empty frame is left
+            } else {                       // replace the page used farthest in the future
+                f = heap.front().second;
+                std::pop_heap(heap.begin(), heap.end());
+                heap.pop_back();
+            }
+            frame.set(f, page);
+        }
+        key[f] = (*nextUse)[now++];
+        heap.push_back(std::make_pair(key[f], f));
+        std::push_heap(heap.begin(), heap.end());
+        if (heap.size() > 2 * (size_t)frames + 16) {  // drop the stale entries
+            heap.clear();
+            for (int j = 0; j < used; j++) heap.push_back(std::make_pair(key[j], j));
+            std::make_heap(heap.begin(), heap.end());
+        }
+        return fault;
+    }
+
+private:
+    std::shared_ptr<const std::vector<long long>> nextUse; // next use of each reference
+    int frames;
+    FrameTable frame;                      // page in each frame
+    std::vector<long long> key;            // next use of the page in each frame
+    std::vector<std::pair<long long, int>> heap; // (next use, frame)
+    long long now = 0;                     // position in the reference string
+    int used = 0;                          // frames filled so far
+};
+
+// ------------------------------------------
+// CLOCK (second chance)
+// ------------------------------------------
+class ClockPolicy : public PagePolicy<ClockPolicy> {
+public:
+    static constexpr const char *NAME = "CLOCK";
+
+    explicit ClockPolicy(int frames) : frames(frames), frame(frames), bit(frames, 0) {}
+
+    bool reference(long long page) {
+        int f = frame.find(page);
+        if (f != -1) { bit[f] = 1; return false; }
+        if (used < frames) {
+            f = used++;                    // an empty frame is left
+        } else {
+            while (bit[hand]) {            // referenced since the last sweep: second chance
+                bit[hand] = 0;
+                hand = hand + 1 == frames ? 0 : hand + 1;
+            }
+            f = hand;
+            hand = hand + 1 == frames ? 0 : hand + 1;
+        }
+        frame.set(f, page);
+        bit[f] = 1;
+        return true;
+    }
+
+private:
+    int frames;
+    FrameTable frame;                      // page in each frame
+    std::vector<char> bit;                 // reference bit of each frame
+    int hand = 0;                          // next frame the hand looks at
+    int used = 0;                          // frames filled so far
+};
+
+// ------------------------------------------
+// LFU with O(1) frequency buckets
+// ------------------------------------------
+// Frames with the same use count form a bucket (a list, most recently used first); the
+// buckets form a list in increasing count order. Buckets are created and dropped as counts
+// appear and disappear, so there are never more than f + 1 of them.
+class LfuPolicy : public PagePolicy<LfuPolicy> {
+public:
+    static constexpr const char *NAME = "LFU";
+
+    explicit LfuPolicy(int frames)
+        : frames(frames), frame(frames), inBucket(frames), prev(frames), next(frames), bucket(frames + 1) {
+        for (int b = frames; b >= 0; b--) spare.push_back(b);
+    }
+
+    bool reference(long long page) {
+        int f = frame.find(page);
+        if (f != -1) {                     // hit: move to the bucket of count + 1
+            int b = inBucket[f], nb = bucket[b].next;
+            if (nb == -1 || bucket[nb].count != bucket[b].count + 1) nb = newBucket(bucket[b].count + 1, b);
+            unlink(f);
+            push(f, nb);
+            return false;
+        }
+        if (used < frames) {
+            f = used++;                    // an empty frame is left
+        } else {                           // evict the least recent page of the lowest count
+            f = bucket[lowest].tail;
+            unlink(f);
+        }
+        frame.set(f, page);
+        int b = lowest;
+        if (b == -1 || bucket[b].count != 1) b = newBucket(1, -1);
+        push(f, b);
+        return true;
+    }
+
+private:
+    struct Bucket { long long count; int prev, next, head, tail; };
+    int frames;
+    FrameTable frame;                      // page in each frame
+    std::vector<int> inBucket, prev, next; // bucket of each frame, links within it
+    std::vector<Bucket> bucket;            // bucket pool
+    std::vector<int> spare;                // free buckets
+    int lowest = -1;                       // bucket with the lowest count, -1 = none
+    int used = 0;                          // frames filled so far
+
+    int newBucket(long long count, int after) { // insert a bucket after 'after' (-1 = first)
+        int b = spare.back();
+        spare.pop_back();
+        Bucket &x = bucket[b];
+        x.count = count;
+        x.head = x.tail = -1;
+        x.prev = after;
+        x.next = after == -1 ? lowest : bucket[after].next;
+        if (x.next != -1) bucket[x.next].prev = b;
+        if (after == -1) lowest = b; else bucket[after].next = b;
+        return b;
+    }
+    void push(int f, int b) {              // f becomes the most recent frame of bucket b
+        inBucket[f] = b;
+        prev[f] = -1;
+        next[f] = bucket[b].head;
+        if (bucket[b].head != -1) prev[bucket[b].head] = f; else bucket[b].tail = f;
+        bucket[b].head = f;
+    }
+    void unlink(int f) {                   // take f out of its bucket, dropping it if empty
+        Bucket &x = bucket[inBucket[f]];
+        if (prev[f] != -1) next[prev[f]] = next[f]; else x.head = next[f];
+        if (next[f] != -1) prev[next[f]] = prev[f]; else x.tail = prev[f];
+        if (x.head != -1) return;
+        if (x.prev != -1) bucket[x.prev].next = x.next; else lowest = x.next;
+        if (x.next != -1) bucket[x.next].prev = x.prev;
+        spare.push_back(inBucket[f]);
+    }
+};
+
+// ------------------------------------------
+// 2Q (full version)
+// ------------------------------------------
+class TwoQPolicy : public PagePolicy<TwoQPolicy> {
+public:
+    static constexpr const char *NAME = "2Q";
+
+    explicit TwoQPolicy(int frames)
+        : frames(frames), kin(std::max(1, frames / 4)), kout(std::max(1, frames / 2)),
+          pages(3, frames + kout) {}
+
+    bool reference(long long page) {
+        int node = pages.find(page);
+        if (node != -1 && pages.listOf(node) == AM) { pages.moveToFront(node, AM); return false; }
+        if (node != -1 && pages.listOf(node) == A1IN) return false;  // stays in FIFO order
+        bool again = node != -1;           // remembered in A1out: seen recently, goes to Am
+        if (again) pages.erase(node);
+        if (pages.size(A1IN) + pages.size(AM) == frames) {  // reclaim a frame
+            if (pages.size(A1IN) > kin || pages.size(AM) == 0) {
+                pages.moveBack(A1IN, A1OUT);  // keep its page number as a ghost
+                if (pages.size(A1OUT) > kout) pages.popBack(A1OUT);
+            } else {
+                pages.popBack(AM);
+            }
+        }
+        pages.pushFront(page, again ? AM : A1IN);
+        return true;
+    }
+
+private:
+    enum { A1IN, AM, A1OUT };              // the lists
+    int frames, kin, kout;                 // frames, A1in target size, A1out size
+    PageLists pages;
+};
+
+// ------------------------------------------
+// ARC (Adaptive Replacement Cache)
+// ------------------------------------------
+class ArcPolicy : public PagePolicy<ArcPolicy> {
+public:
+    static constexpr const char *NAME = "ARC";
+
+    explicit ArcPolicy(int frames) : c(frames), pages(4, 2 * frames) {}
+
+    bool reference(long long page) {
+        int node = pages.find(page);
+        int list = node == -1 ? -1 : pages.listOf(node);
+        if (list == T1 || list == T2) { pages.moveToFront(node, T2); return false; }
+
+        if (list == B1) {                  // T1 was too small: grow its target
+            p = std::min<double>(c, p + std::max(1.0, (double)pages.size(B2) / pages.size(B1)));
+            replace(false);
+            pages.moveToFront(node, T2);
+            return true;
+        }
+        if (list == B2) {                  // T2 was too small: shrink T1's target
+            p = std::max(0.0, p - std::max(1.0, (double)pages.size(B1) / pages.size(B2)));
+            replace(true);
+            pages.moveToFront(node, T2);
+            return true;
+        }
+
+        // Not seen recently at all
+        int l1 = pages.size(T1) + pages.size(B1);
+        int all = l1 + pages.size(T2) + pages.size(B2);
+        if (l1 == c) {
+            if (pages.size(T1) < c) { pages.popBack(B1); replace(false); }
+            else pages.popBack(T1);        // B1 is empty: drop T1's oldest for good
+        } else if (all >= c) {
+            if (all == 2 * c) pages.popBack(B2);
+            replace(false);
+        }
+        pages.pushFront(page, T1);
+        return true;
+    }
+
+private:
+    enum { T1, T2, B1, B2 };               // the lists
+    int c;                                 // frames
+    double p = 0;                          // target size of T1
+    PageLists pages;
+
+    void replace(bool inB2) {              // free a frame, remembering the page as a ghost
+        int t1 = pages.size(T1);
+        if (t1 >= 1 && ((inB2 && t1 == p) || t1 > p)) pages.moveBack(T1, B1);
+        else pages.moveBack(T2, B2);
+    }
+};
+
+// ------------------------------------------
+// LIRS (Low Inter-reference Recency Set)
+// ------------------------------------------
+// Stack S holds pages in recency order: every LIR page, plus HIR pages (resident or not)
+// referenced more recently than the oldest LIR page; its bottom is always a LIR page.
+// Queue Q holds the resident HIR pages in FIFO order; its front is the next victim. A page
+// can be in both. A HIR page referenced again while still in S has a shorter reuse distance
+// than the oldest LIR page, so the two swap status.
+class LirsPolicy : public PagePolicy<LirsPolicy> {
+public:
+    static constexpr const char *NAME = "LIRS";
+
+    explicit LirsPolicy(int frames)
+        : frames(frames), lirTarget(frames - std::max(1, frames / 100)) {
+        where.reset(3 * frames);           // resident pages and at most 2 * frames ghosts
+    }
+
+    bool reference(long long page) {
+        if (frames == 1) {                 // no room for both a LIR and a HIR page: plain LRU
+            bool fault = page != only;
+            only = page;
+            return fault;
+        }
+        int x = where.find(page);
+        if (x != -1 && node[x].state == LIR) {
+            bool bottom = x == sTail;
+            sUnlink(x);
+            sPush(x);
+            if (bottom) prune();
+            return false;
+        }
+        if (x != -1 && node[x].state == HIR) {
+            if (node[x].inS) {             // reuse distance beats the oldest LIR page
+                sUnlink(x);
+                sPush(x);
+                unlink(q, x);
+                node[x].state = LIR;
+                lirCount++;
+                demote();
+            } else {
+                sPush(x);
+                unlink(q, x);
+                push(q, x);
+            }
+            return false;
+        }
+
+        // Page fault
+        if (x != -1) {                     // a ghost: it comes back as LIR below
+            unlink(ghosts, x);
+            ghostCount--;
+        }
+        if (resident < frames) {
+            resident++;                    // an empty frame is left
+        } else {                           // evict the front of Q
+            int v = q.head;
+            unlink(q, v);
+            if (node[v].inS) {             // S still remembers it: a ghost
+                node[v].state = NONRESIDENT;
+                push(ghosts, v);
+                if (++ghostCount > 2 * frames) dropGhost(ghosts.head); // the lowest in S
+            } else {
+                release(v);
+            }
+        }
+        if (x != -1) {                     // non-resident but still in S: it becomes LIR
+            sUnlink(x);
+            sPush(x);
+            node[x].state = LIR;
+            lirCount++;
+            demote();
+        } else {
+            x = acquire(page);
+            sPush(x);
+            if (lirCount < lirTarget) {    // warming up: the first pages are LIR
+                node[x].state = LIR;
+                lirCount++;
+            } else {
+                node[x].state = HIR;
+                push(q, x);
+            }
+        }
+        return true;
+    }
+
+private:
+    enum { LIR, HIR, NONRESIDENT };
+    struct Node { long long page; int state; bool inS, inQ; int sPrev, sNext, qPrev, qNext; };
+    int frames, lirTarget;                 // frames, LIR pages wanted (>= 1 from 2 frames on)
+    long long only = NO_PAGE;              // 1 frame: the resident page
+    int lirCount = 0, resident = 0;        // LIR pages, resident pages
+    std::vector<Node> node;                // node pool
+    std::vector<int> spare;                // free nodes
+    PageIndex<> where;                     // page -> node (resident or in S)
+    int sHead = -1, sTail = -1;            // S: top (most recent) and bottom
+    struct Fifo { int head = -1, tail = -1; };
+    Fifo q;                                // Q: resident HIR pages, front = next victim
+    Fifo ghosts;                           // non-resident pages in S, lowest in S first
+    int ghostCount = 0;                    // at most 2 * frames, so memory follows the frames
+
+    int acquire(long long page) {
+        int x;
+        if (!spare.empty()) { x = spare.back(); spare.pop_back(); }
+        else { x = node.size(); node.push_back(Node()); }
+        node[x].page = page;
+        node[x].inS = node[x].inQ = false;
+        where.set(page, x);
+        return x;
+    }
+    void release(int x) { where.erase(node[x].page); spare.push_back(x); }
+
+    void sPush(int x) {                    // x goes on top of S
+        node[x].inS = true;
+        node[x].sPrev = -1;
+        node[x].sNext = sHead;
+        if (sHead != -1) node[sHead].sPrev = x; else sTail = x;
+        sHead = x;
+    }
+    void sUnlink(int x) {
+        if (!node[x].inS) return;
+        node[x].inS = false;
+        if (node[x].sPrev != -1) node[node[x].sPrev].sNext = node[x].sNext; else sHead = node[x].sNext;
+        if (node[x].sNext != -1) node[node[x].sNext].sPrev = node[x].sPrev; else sTail = node[x].sPrev;
+    }
+    void push(Fifo &l, int x) {            // x goes to the back of l (Q or the ghosts)
+        node[x].inQ = true;
+        node[x].qNext = -1;
+        node[x].qPrev = l.tail;
+        if (l.tail != -1) node[l.tail].qNext = x; else l.head = x;
+        l.tail = x;
+    }
+    void unlink(Fifo &l, int x) {
+        if (!node[x].inQ) return;
+        node[x].inQ = false;
+        if (node[x].qPrev != -1) node[node[x].qPrev].qNext = node[x].qNext; else l.head = node[x].qNext;
+        if (node[x].qNext != -1) node[node[x].qNext].qPrev = node[x].qPrev; else l.tail = node[x].qPrev;
+    }
+    void dropGhost(int x) {                // forget a non-resident page altogether
+        unlink(ghosts, x);
+        ghostCount--;
+        sUnlink(x);
+        release(x);
+    }
+
+    void prune() {                         // drop HIR pages from the bottom of S
+        while (sTail != -1 && node[sTail].state != LIR) {
+            int x = sTail;
+            if (node[x].state == NONRESIDENT) dropGhost(x);
+            else sUnlink(x);
+        }
+    }
+    void demote() {                        // too many LIR pages: the oldest becomes HIR
+        // (prune() keeps a LIR page at the bottom of S whenever there is one)
+        while (lirCount > lirTarget && sTail != -1 && node[sTail].state == LIR) {
+            int x = sTail;
+            sUnlink(x);
+            node[x].state = HIR;
+            lirCount--;
+            push(q, x);
+            prune();
+        }
+    }
+};
+
+#endif
@@ -10,26 +10,97 @@
 
     WHAT DOES THIS PROGRAM DO?
     - Accepts number of frames, number of references, and the reference string.
-    - Implements FIFO, LRU, and Optimal page replacement policies.
+    - Implements FIFO, LRU, Optimal, CLOCK, LFU, 2Q, ARC and LIRS page replacement
+      (page_policies.h).
     - Prints the total number of page faults for the selected algorithm.
+    - Batch mode for large runs: page_replace --frames F --algo POLICY[,POLICY...] --trace FILE
+      where POLICY is fifo, lru, optimal, clock, lfu, 2q, arc or lirs (or --algo all).
+      All the policies see the same references, so their fault counts compare directly.
+      Without Optimal the file is streamed in chunks, so it can be far larger than RAM.
+    - Many frame counts at once: page_replace --sweep --trace FILE --frames F1,F2,...
+      [--algo POLICY,...|all] [--threads N] [--out FILE] runs every policy (default fifo,
+      lru, optimal) at every frame count on a pool of threads and writes one CSV table:
+      policy,frames,faults,fault_rate. Build with threads enabled:
+          g++ -O2 -pthread page_replace.cpp -o page_replace
+    - Trace files (every --trace mode): page numbers as text by default; --format addr reads
+      raw 64-bit binary addresses, --format lackey the output of valgrind's Lackey tool
+      ("-" = standard input). Addresses map to pages of --page-size bytes (4K default, 2M for
+      huge pages). See page_trace.h.
+    - Miss-ratio curves: page_replace --mrc --trace FILE [--opt] [--max-frames F] [--out FILE]
+      prints the LRU faults (and with --opt the Optimal faults) for every frame count from 1
+      up, all from one pass over the trace, as CSV: frames,lru_faults,lru_miss_ratio[,...].
+    - Approximate LRU curves for huge traces: page_replace --shards --trace FILE [--rate R]
+      [--samples S] [--out FILE] samples a fraction R of the pages (default 0.01), or at most
+      S pages with the rate lowered as needed. Adds an error_bound column (95%, treating the
+      sampled pages as independent) and prints the sample size and worst bound to stderr.
+    - Working sets: page_replace --wss --trace FILE --window D1,D2,... [--every N] tracks
+      |W(t, D)|, the distinct pages in the last D references, for every window D in one pass
+      and writes its mean over each N references (default 10000) as CSV: t,wss_D1,...
+      The mean, the peak and the faults of the working-set policy go to stderr.
+    - Page fault frequency: page_replace --pff T --trace FILE [--every N] lets the resident
+      set grow on faults less than T references apart and drops the pages unused since the
+      last fault otherwise; CSV t,resident,faults per N references. See working_set.h.
+    - Several processes on one machine: page_replace --multi --trace FILE1,FILE2,... --frames F
+      [--algo POLICY] [--scope local|global] [--quota Q1,...] [--quantum Q] interleaves the
+      traces (one per process, Q references per turn) over F shared frames. Local replacement
+      gives each process its own quota of frames (default an equal share), global replacement
+      lets all of them compete under one policy. It runs 1, 2, ... processes at once and
+      writes every process's fault rate at each degree of multiprogramming as CSV; the degree
+      where the overall fault rate jumps (by --thrash X, default 2 times) is reported as
+      thrashing: the frames hold one process fewer than that, a memory limit to plan with.
+    - Translation cost: add --tlb to a batch run to put a set-associative TLB (--tlb-entries,
+      --tlb-ways, --tlb-repl lru|random) and a 4-level page table walk (3 levels with
+      --page-size 2M, 2 with 1G; --pwc N paging-structure cache entries) in front of every
+      policy. Each policy then also reports its TLB hit rate, page walk memory accesses and
+      effective access time (--tlb-ns, --mem-ns, --fault-ns). See tlb.h.
+
+    HOW IS IT FAST?
+    - Any number of frames and references (vectors, 64-bit page numbers).
+    - Every policy is O(1) per reference (Optimal O(log f) per fault) and inlined into the
+      loop over the references; see page_policies.h.
+    - Up to 64 frames, FIFO, CLOCK, LFU and Optimal find pages by comparing the whole frame
+      array with SIMD instructions (AVX2 or SSE4.1, picked at run time) instead of hashing.
+    - --sweep reads the trace once and shares it, read-only, between all the threads.
+    - The miss-ratio curve uses stack distances (Mattson): LRU counts the distinct pages since
+      a page's last use in a Fenwick tree over time, O(log n) per reference in memory that
+      grows with the distinct pages only. The Optimal curve walks a priority stack, O(depth)
+      per reference, so --max-frames bounds its cost.
+    - --shards tracks only the pages whose hash is below a threshold (SHARDS): with R = 0.001
+      a thousandth of the pages and references, and with --samples memory is fixed.
+    - A TLB lookup compares one set's tags in a single pass and is inlined into each
+      policy's loop; page walks happen only on TLB misses.
+    - --wss never rescans a window: a page enters W(t, D) when its last access is more than D
+      references back and leaves when its latest reference falls out, O(1) per reference.
 */
 
-#include <iostream>     // For cout, cin
-using namespace std;    // Use the standard namespace to avoid prefixing std::
+#include <iostream>         // For cout, cin
+#include <fstream>          // For ofstream (--out FILE)
+#include <vector>           // For vector (frames and references of any size)
+#include <string>           // For string (policy names)
+#include <memory>           // For unique_ptr (the policies of a batch run)
+#include <thread>           // For thread (--sweep worker pool)
+#include <atomic>           // For atomic<int> (next sweep job)
+#include <chrono>           // For steady_clock (sweep time)
+#include <algorithm>        // For min, max, fill
+#include <queue>            // For priority_queue (SHARDS sample by hash)
+#include <cmath>            // For llround, ceil, sqrt
+#include <cstdlib>          // For atoi, atoll, atof, strtoll
+#include <climits>          // For LLONG_MAX, INT_MAX
+#include "proc_trace.h"     // For argValue(), argFlag()
+#include "page_policies.h"  // For the replacement policies, PageIndex, nextUses()
+#include "page_trace.h"     // For PageTraceReader (--trace FILE)
+#include "working_set.h"    // For WorkingSet, PffPolicy (--wss, --pff)
+#include "tlb.h"            // For AddressTranslation (--tlb)
+using namespace std;        // Use the standard namespace to avoid prefixing std::
 
 class VirtualMemory {
 public:
-    int frames[20];        // physical memory frames (holds pages)
-    int fsize;             // number of frames actually used
-    int ref[50];           // reference string (sequence of page requests)
-    int n;                 // length of reference string
-    int pageFaults;        // counter for page faults
+    int fsize;                 // number of frames
+    vector<long long> ref;     // reference string (sequence of page requests)
+    long long n;               // length of reference string
+    long long pageFaults;      // counter for page faults
 
-    VirtualMemory() {                      // Constructor to initialize frames and faults
-        for (int i = 0; i < 20; i++)       // Initialize all frame slots
-            frames[i] = -1;               // -1 indicates empty frame
-        pageFaults = 0;                   // Initialize page fault count to 0
-    }
+    VirtualMemory() : fsize(0), n(0), pageFaults(0) {} // Constructor: no frames or references yet
 
     void enterInput() {                    // Function to take input from user
         cout << "\nEnter number of frames: "; // Prompt for number of frames
@@ -37,150 +108,849 @@ public:
 
         cout << "Enter number of references: "; // Prompt for length of reference string
         cin >> n;                          // Read length
+        ref.resize(n);
 
         cout << "Enter reference string:\n"; // Prompt for actual reference string values
-        for (int i = 0; i < n; i++)        // Loop to read n page numbers
+        for (long long i = 0; i < n; i++)  // Loop to read n page numbers
             cin >> ref[i];                 // Read each page reference into array
     }
 
-    // Check if page exists in frames; return index if found, -1 if not
-    int search(int page) {
-        for (int i = 0; i < fsize; i++)    // Check all used frames
-            if (frames[i] == page)         // If page matches frame content
-                return i;                  // Return frame index
-        return -1;                         // Page not present in frames
+    // Run one replacement policy (page_policies.h) over the reference string
+    template <class Policy>
+    void simulate(Policy policy) {
+        cout << "\n--- " << Policy::NAME << " Page Replacement ---\n"; // Header
+        policy.run(ref.begin(), ref.end()); // Every reference, in order
+        pageFaults = policy.faults();
+        cout << "Total Page Faults (" << Policy::NAME << "): " << pageFaults << "\n"; // Print result
     }
+};
 
-    // ------------------------------------------
-    // FIFO (First-In-First-Out)
-    // ------------------------------------------
-    void FIFO() {
-        cout << "\n--- FIFO Page Replacement ---\n"; // Header
-        int index = 0;                      // Points to next frame to replace (circular)
-        pageFaults = 0;                    // Reset fault counter
+// ------------------------------------------
+// Miss-ratio curves (Mattson stack algorithms)
+// ------------------------------------------
+// LRU and Optimal are stack algorithms: the pages held by f frames are always among those held
+// by f + 1 frames, so all memory sizes can share one stack of pages. A reference whose page
+// is at depth d of the stack (its stack distance) hits in every memory of d frames or more,
+// and one pass that counts the distances gives the faults for every frame count at once.
+
+// Stack distances, counted up to maxDepth (deeper references and first references are misses
+// for every frame count up to maxDepth)
+class DistanceHistogram {
+public:
+    DistanceHistogram(long long maxDepth) : maxDepth(maxDepth) {}
 
-        for (int i = 0; i < n; i++) {      // For each page reference in the string
-            int page = ref[i];             // Current requested page
+    void add(long long d) {                // d = 0: not in the stack
+        if (d <= 0 || d > maxDepth) { beyond++; return; }
+        if (d >= (long long)count.size()) count.resize(d + 1);
+        count[d]++;
+    }
 
-            if (search(page) == -1) {      // If page not present (page fault)
-                frames[index] = page;      // Place page into frame at 'index'
-                index = (index + 1) % fsize; // Advance index circularly
-                pageFaults++;              // Increment page fault count
-            }
-            // if page is present, nothing to do (no fault)
+    long long depth() const { return count.empty() ? 0 : count.size() - 1; } // deepest hit
+    vector<long long> faults() const {     // faults for 0 .. depth() frames
+        vector<long long> f(max<size_t>(count.size(), 1), beyond);
+        for (long long d = (long long)f.size() - 2; d >= 0; d--) f[d] = f[d + 1] + count[d + 1];
+        return f;
+    }
+
+private:
+    long long maxDepth;                    // deepest distance counted
+    vector<long long> count;               // count[d] = references at distance d
+    long long beyond = 0;                  // references deeper than maxDepth or never seen
+};
+
+// LRU stack distances without the stack: the distance of a reference is the number of distinct
+// pages used since the previous reference to its page, itself included. Every page marks the
+// time of its latest reference in a Fenwick tree over time, so the distance is a count of
+// marks after that time: O(log t) per reference.
+class LruStackDistance {
+public:
+    LruStackDistance() { last.reset(1024); rebuild(0, 1024); }
+
+    long long access(long long page) {     // stack distance of this reference, 0 if first
+        long long d = 0;
+        long long t = last.find(page);
+        if (t != -1) {
+            d = live - prefix(t) + 1;      // pages used after t, plus this one
+            add(t, -1);
+            owner[t] = -1;
+            live--;
         }
+        if (now == (long long)owner.size()) compact();
+        owner[now] = page;
+        add(now, 1);
+        last.set(page, now);
+        now++;
+        live++;
+        return d;
+    }
 
-        cout << "Total Page Faults (FIFO): " << pageFaults << "\n"; // Print result
+    void remove(long long page) {          // forget a page (it must have been seen)
+        long long t = last.find(page);
+        add(t, -1);
+        owner[t] = -1;
+        live--;
+        last.erase(page);
     }
 
-    // ------------------------------------------
-    // LRU (Least Recently Used)
-    // ------------------------------------------
-    void LRU() {
-        cout << "\n--- LRU Page Replacement ---\n"; // Header
-        pageFaults = 0;                    // Reset fault count
-        int time[20];                      // Array to store last used time (logical clock) per frame
-        int t = 0;                         // Logical time counter
+    long long distinct() const { return live; }  // pages seen so far (and not removed)
 
-        for (int i = 0; i < fsize; i++)    // Initialize time array
-            time[i] = -1;                  // -1 indicates frame not yet used
+private:
+    PageIndex<long long> last;             // page -> time of its latest reference
+    vector<long long> owner;               // page whose latest reference is at each time, -1 if none
+    vector<int> tree;                      // Fenwick tree over time: 1 at every latest reference
+    long long now = 0;                     // next time
+    long long live = 0;                    // marks in the tree (distinct pages)
 
-        for (int i = 0; i < n; i++) {      // For each reference
-            int page = ref[i];             // Requested page
-            int pos = search(page);        // Check if page exists in frames
+    void add(long long t, int v) {
+        for (t++; t < (long long)tree.size(); t += t & -t) tree[t] += v;
+    }
+    long long prefix(long long t) const {  // marks at times 0 .. t
+        long long s = 0;
+        for (t++; t > 0; t -= t & -t) s += tree[t];
+        return s;
+    }
 
-            if (pos != -1) {               // If page is found (hit)
-                time[pos] = t++;           // Update its last-used time to current time then increment time
+    // Out of time slots: renumber the live marks 0 .. live-1 (in order), so memory stays
+    // proportional to the distinct pages rather than to the length of the trace
+    void compact() {
+        long long j = 0;
+        for (long long t = 0; t < now; t++)
+            if (owner[t] != -1) {
+                owner[j] = owner[t];
+                last.set(owner[j], j);
+                j++;
             }
-            else {                         // Page fault: need to replace LRU page
-                int lruIndex = 0;          // Assume frame 0 is LRU initially
-                for (int j = 1; j < fsize; j++) // Find frame with smallest time value
-                    if (time[j] < time[lruIndex]) lruIndex = j; // Update lruIndex if a smaller last-used time found
-
-                frames[lruIndex] = page;  // Replace the LRU frame with the new page
-                time[lruIndex] = t++;     // Set its last-used time to current time then increment
-                pageFaults++;             // Increment page fault count
+        rebuild(j, 2 * j + 1024);
+    }
+    void rebuild(long long marks, long long capacity) { // marks at times 0 .. marks-1
+        owner.resize(capacity);
+        fill(owner.begin() + marks, owner.end(), -1);
+        tree.assign(capacity + 1, 0);
+        for (long long i = 1; i <= capacity; i++) {  // linear-time Fenwick construction
+            tree[i] += i <= marks;
+            long long up = i + (i & -i);
+            if (up <= capacity) tree[up] += tree[i];
+        }
+        now = marks;
+    }
+};
+
+// Optimal stack distances (Mattson et al.): the stack is ordered by priority, where the page
+// needed sooner has the higher priority. The referenced page goes on top, then going down,
+// each level keeps the sooner-needed of the page already there and the page pushed down from
+// above, until the level where the referenced page was. O(depth) per reference, so the stack
+// is cut at maxDepth.
+void optStackDistances(const vector<long long> &ref, long long maxDepth, DistanceHistogram &h)
+{
+    vector<long long> nextUse = nextUses(ref);
+    vector<long long> page, next;          // the stack, top first: pages and their next use
+    for (size_t t = 0; t < ref.size(); t++) {
+        long long carry = ref[t], carryNext = nextUse[t]; // page moving down the stack
+        long long d = 0;
+        size_t i = 0;
+        for (; i < page.size(); i++) {
+            if (page[i] == ref[t]) {       // its old level takes the page pushed down
+                page[i] = carry;
+                next[i] = carryNext;
+                d = i + 1;
+                break;
+            }
+            if (i == 0 || next[i] > carryNext) {
+                swap(page[i], carry);
+                swap(next[i], carryNext);
+            }
+        }
+        if (d == 0 && (long long)page.size() < maxDepth) {  // not in the stack: it grows
+            page.push_back(carry);
+            next.push_back(carryNext);
+        }
+        h.add(d);
+    }
+}
+
+// Approximate LRU curve by spatial sampling (SHARDS, Waldspurger et al., FAST 2015): only the
+// pages whose hash falls below a threshold are tracked, i.e. a fraction R of all pages. Among
+// those, a stack distance d stands for about d / R distinct pages of the full trace, and each
+// sampled reference for 1 / R references. With a sample size limit the threshold starts at the
+// given rate and is lowered (dropping the pages with the largest hash) whenever more pages
+// than the limit are tracked, so memory stays bounded however long the trace is.
+class ShardsMrc {
+public:
+    static const long long P = 1 << 24;    // hash values 0 .. P-1
+
+    ShardsMrc(double rate, long long maxPages) : maxPages(maxPages) {
+        threshold = max(1LL, min(P, (long long)llround(rate * P)));
+        width = 1 / this->rate();
+        maxBins = maxPages > 0 ? 2 * maxPages + 1024 : LLONG_MAX;
+    }
+
+    void access(long long page) {
+        refs++;
+        long long h = pageHash(page) & (P - 1);
+        if (h >= threshold) return;        // not in the sample
+        sampled++;
+        long long d = lru.access(page);
+        if (d > 0) {                       // distance in frames of the full trace: d / R
+            long long b = (long long)ceil(d / rate() / width - 1e-9) - 1;
+            while (b >= maxBins) { merge(); b /= 2; }
+            if (b >= (long long)count.size()) count.resize(b + 1);
+            count[b] += 1 / scale;
+        } else {
+            cold += 1 / scale;
+            if (maxPages > 0) {
+                byHash.push(make_pair(h, page));
+                while (lru.distinct() > maxPages) lower();
             }
         }
+    }
 
-        cout << "Total Page Faults (LRU): " << pageFaults << "\n"; // Print result
+    double rate() const { return (double)threshold / P; }
+    long long references() const { return refs; }
+    long long sampledReferences() const { return sampled; }
+    long long sampledPages() const { return lru.distinct(); }
+
+    // Estimated (frames, miss ratio) points: one per histogram bin
+    vector<pair<double, double>> curve() const {
+        vector<double> c(max<size_t>(count.size(), 1));
+        double total = cold * scale;
+        for (size_t b = 0; b < count.size(); b++) total += c[b] = count[b] * scale;
+        // SHARDS-adj: the sample rarely holds exactly refs * R references; the difference is
+        // put on the shortest distances, where it distorts the curve least
+        double expected = refs * rate();
+        c[0] += expected - total;
+        vector<pair<double, double>> m(c.size());
+        double misses = cold * scale;
+        for (long long b = c.size() - 1; b >= 0; b--) {
+            double ratio = expected > 0 ? misses / expected : 0;
+            m[b] = make_pair((b + 1) * width, min(1.0, max(0.0, ratio)));
+            misses += c[b];
+        }
+        return m;
     }
 
-    // ------------------------------------------
-    // Optimal Page Replacement
-    // ------------------------------------------
-    void Optimal() {
-        cout << "\n--- Optimal Page Replacement ---\n"; // Header
-        pageFaults = 0;                    // Reset fault count
+private:
+    long long maxPages;                    // sample size limit, 0 = none (fixed rate)
+    long long threshold;                   // pages with hash < threshold are sampled
+    LruStackDistance lru;                  // stack distances among the sampled pages
+    vector<double> count;                  // count[b] * scale = references at distance bin b
+    double width;                          // bin b holds distances (b * width, (b+1) * width]
+    long long maxBins;                     // bins kept before they are merged pairwise
+    double cold = 0;                       // cold * scale = first references
+    double scale = 1;                      // product of every R' / R so far
+    long long refs = 0, sampled = 0;       // references seen, references sampled
+    priority_queue<pair<long long, long long>> byHash; // sampled pages by hash, largest on top
+
+    void lower() {                         // drop the pages with the largest hash
+        long long top = byHash.top().first;
+        while (!byHash.empty() && byHash.top().first == top) {
+            lru.remove(byHash.top().second);
+            byHash.pop();
+        }
+        scale *= (double)top / threshold;  // counts so far were collected at the old rate
+        threshold = top;
+    }
 
-        for (int i = 0; i < fsize; i++)    // Reinitialize frames to empty
-            frames[i] = -1;
+    void merge() {                         // double the bin width
+        for (size_t b = 0; b < count.size(); b++) {
+            double v = count[b];
+            count[b] = 0;
+            count[b / 2] += v;
+        }
+        count.resize((count.size() + 1) / 2);
+        width *= 2;
+    }
+};
 
-        for (int i = 0; i < n; i++) {      // For each reference position i
-            int page = ref[i];             // Current requested page
+// Read a whole trace into ref (for Optimal, which looks ahead); false on errors
+bool readWhole(PageTraceReader &trace, vector<long long> &ref)
+{
+    vector<long long> chunk;
+    while (trace.next(chunk)) ref.insert(ref.end(), chunk.begin(), chunk.end());
+    return !trace.failed;
+}
 
-            if (search(page) != -1)        // If page already present, continue (no fault)
-                continue;
+// ------------------------------------------
+// Batch runs: several policies over one reference stream
+// ------------------------------------------
+const char *POLICIES[] = {"fifo", "lru", "optimal", "clock", "lfu", "2q", "arc", "lirs"};
+const int NPOLICIES = 8;
+
+// One policy of a batch run. References arrive in chunks: the virtual call is made once per
+// chunk, the loop over the chunk is the policy's own inlined run().
+struct PolicyRun {
+    virtual ~PolicyRun() {}
+    virtual void feed(const long long *refs, size_t count) = 0;
+    virtual long long faults() const = 0;
+    virtual const char *name() const = 0;
+    virtual const AddressTranslation *translation() const { return nullptr; } // --tlb runs only
+};
 
-            int empty = -1;                // Check if any empty frame exists
-            for (int j = 0; j < fsize; j++) {
-                if (frames[j] == -1) {    // Found empty frame
-                    empty = j;            // Store index and break
-                    break;
-                }
-            }
+template <class Policy>
+struct PolicyRunOf : PolicyRun {
+    Policy policy;
+    PolicyRunOf(Policy policy) : policy(policy) {}
+    void feed(const long long *refs, size_t count) override { policy.run(refs, refs + count); }
+    long long faults() const override { return policy.faults(); }
+    const char *name() const override { return Policy::NAME; }
+};
+
+// A policy behind a TLB and page table (tlb.h): every reference is translated, then looked up
+template <class Policy>
+struct TranslatedRunOf : PolicyRunOf<Policy> {
+    AddressTranslation mmu;
+    TranslatedRunOf(Policy policy, const TlbSpec &spec) : PolicyRunOf<Policy>(policy), mmu(spec) {}
+    void feed(const long long *refs, size_t count) override {
+        for (size_t i = 0; i < count; i++) mmu.translate(refs[i], this->policy.access(refs[i]));
+    }
+    const AddressTranslation *translation() const override { return &mmu; }
+};
+
+// Policy number id (index into POLICIES) with f frames, wrapped in Run<Policy> (built from
+// the policy and extra); nextUse (from nextUses()) is only used by Optimal
+template <template <class> class Run, class... Extra>
+unique_ptr<PolicyRun> makeRun(int id, int f, const shared_ptr<const vector<long long>> &nextUse,
+                              const Extra &...extra)
+{
+    switch (id) {
+    case 0: return unique_ptr<PolicyRun>(new Run<FifoPolicy>(FifoPolicy(f), extra...));
+    case 1: return unique_ptr<PolicyRun>(new Run<LruPolicy>(LruPolicy(f), extra...));
+    case 2: return unique_ptr<PolicyRun>(new Run<OptimalPolicy>(OptimalPolicy(f, nextUse), extra...));
+    case 3: return unique_ptr<PolicyRun>(new Run<ClockPolicy>(ClockPolicy(f), extra...));
+    case 4: return unique_ptr<PolicyRun>(new Run<LfuPolicy>(LfuPolicy(f), extra...));
+    case 5: return unique_ptr<PolicyRun>(new Run<TwoQPolicy>(TwoQPolicy(f), extra...));
+    case 6: return unique_ptr<PolicyRun>(new Run<ArcPolicy>(ArcPolicy(f), extra...));
+    default: return unique_ptr<PolicyRun>(new Run<LirsPolicy>(LirsPolicy(f), extra...));
+    }
+}
+
+unique_ptr<PolicyRun> makePolicy(int id, int f, const shared_ptr<const vector<long long>> &nextUse)
+{
+    return makeRun<PolicyRunOf>(id, f, nextUse);
+}
+
+// Policies named in a comma-separated list ("all" = every policy); false on unknown names
+bool parsePolicies(const char *list, vector<int> &ids)
+{
+    string s = list;
+    if (s == "all") s = "fifo,lru,optimal,clock,lfu,2q,arc,lirs";
+    for (size_t a = 0; a <= s.size(); ) {
+        size_t b = s.find(',', a);
+        if (b == string::npos) b = s.size();
+        string name = s.substr(a, b - a);
+        int id = 0;
+        while (id < NPOLICIES && name != POLICIES[id]) id++;
+        if (id == NPOLICIES) { cerr << "unknown policy: " << name << "\n"; return false; }
+        ids.push_back(id);
+        a = b + 1;
+    }
+    return true;
+}
+
+// Batch mode: page_replace --frames F --algo POLICY[,POLICY...]|all --trace FILE [--tlb ...]
+// With tlb set, every policy runs behind its own TLB and page table model.
+int runTrace(const char *path, const PageTraceSpec &spec, const char *frames, const char *algo,
+             const TlbSpec *tlb)
+{
+    int f = atoll(frames);
+    vector<int> ids;
+    if (f <= 0 || !parsePolicies(algo, ids)) {
+        cerr << "usage: page_replace --frames F --algo fifo|lru|optimal|clock|lfu|2q|arc|lirs[,...]|all"
+                " --trace FILE\n";
+        return 1;
+    }
+    PageTraceReader trace(path, spec);
+    if (trace.failed) return 1;
+
+    // Optimal looks ahead, so with it the whole string is read first; otherwise the file is
+    // streamed, every chunk going to every policy in turn
+    bool whole = false;
+    for (int id : ids) whole |= id == 2;
+    vector<long long> ref, chunk;
+    vector<unique_ptr<PolicyRun>> runs;
+    if (whole && !readWhole(trace, ref)) return 1;
+    auto nextUse = make_shared<const vector<long long>>(whole ? nextUses(ref) : vector<long long>());
+    for (int id : ids)
+        runs.push_back(tlb ? makeRun<TranslatedRunOf>(id, f, nextUse, *tlb) : makePolicy(id, f, nextUse));
+
+    long long refs = ref.size();
+    if (whole) {
+        for (auto &r : runs) r->feed(ref.data(), ref.size());
+    } else {
+        while (trace.next(chunk)) {
+            for (auto &r : runs) r->feed(chunk.data(), chunk.size());
+            refs += chunk.size();
+        }
+        if (trace.failed) return 1;
+    }
+
+    for (auto &r : runs) {
+        cout << "\n--- " << r->name() << " Page Replacement ---\n";
+        cout << "Total Page Faults (" << r->name() << "): " << r->faults() << "\n";
+        cout << "Fault Rate: " << (refs ? (double)r->faults() / refs : 0) << "\n";
+        if (const AddressTranslation *t = r->translation()) {
+            cout << "TLB Hit Rate: " << (refs ? (double)t->tlbHits() / refs : 0) << "\n";
+            cout << "Page Walk Memory Accesses: " << t->walkMemoryAccesses() << " ("
+                 << t->walkLevels() << "-level table)\n";
+            cout << "Effective Access Time: " << t->effectiveAccessNs() << " ns\n";
+        }
+    }
+    cout << "References: " << refs << "\n";
+    return 0;
+}
+
+// Comma-separated counts "N1,N2,..." from 1 to max; v is left empty if any is invalid
+void parseCounts(const char *s, long long max, vector<long long> &v)
+{
+    v.clear();
+    while (s && *s) {
+        char *end;
+        long long x = strtoll(s, &end, 10);
+        if (end == s || x <= 0 || x > max || (*end && *end != ',')) { v.clear(); return; }
+        v.push_back(x);
+        s = *end ? end + 1 : end;
+    }
+}
+
+// Sweep mode: page_replace --sweep --trace FILE --frames F1,F2,... [--algo POLICY,...|all]
+//             [--threads N] [--out FILE]
+// Every (policy, frame count) pair is one job. The trace is read once; all threads share
+// the same read-only reference array (and one next-use array for Optimal). Jobs are handed
+// out from an atomic counter, as in sched_sweep.cpp.
+int runSweep(const char *path, const PageTraceSpec &spec, int argc, char *argv[])
+{
+    const char *usage = "usage: page_replace --sweep --trace FILE --frames F1,F2,... [--algo POLICY,...|all]\n"
+                        "                    [--threads N] [--out FILE]\n";
+    vector<long long> frames;
+    vector<int> ids;
+    parseCounts(argValue(argc, argv, "--frames"), INT_MAX, frames);
+    const char *algo = argValue(argc, argv, "--algo");
+    int threads = max(1u, thread::hardware_concurrency()); // 0 if unknown
+    if (const char *t = argValue(argc, argv, "--threads")) threads = atoi(t);
+    if (frames.empty() || !parsePolicies(algo ? algo : "fifo,lru,optimal", ids) || threads <= 0) {
+        cerr << usage;
+        return 1;
+    }
 
-            if (empty != -1) {            // If empty frame found
-                frames[empty] = page;     // Place page there
-                pageFaults++;             // Count page fault
-                continue;                 // Move to next reference
+    // The shared input
+    PageTraceReader trace(path, spec);
+    vector<long long> ref;
+    if (trace.failed || !readWhole(trace, ref)) return 1;
+    bool optimal = false;
+    for (int id : ids) optimal |= id == 2;
+    auto nextUse = make_shared<const vector<long long>>(optimal ? nextUses(ref) : vector<long long>());
+
+    struct SweepJob { int id; long long frames, faults; };
+    vector<SweepJob> jobs;
+    for (int id : ids)
+        for (long long f : frames) jobs.push_back(SweepJob{id, f, 0});
+
+    // Thread pool: each worker takes the next job until none are left
+    auto start = chrono::steady_clock::now();
+    atomic<int> nextJob(0);
+    vector<thread> pool;
+    threads = min<int>(threads, jobs.size());
+    for (int t = 0; t < threads; t++)
+        pool.emplace_back([&]() {
+            for (int j; (j = nextJob.fetch_add(1)) < (int)jobs.size(); ) {
+                unique_ptr<PolicyRun> run = makePolicy(jobs[j].id, jobs[j].frames, nextUse);
+                run->feed(ref.data(), ref.size());
+                jobs[j].faults = run->faults();
             }
+        });
+    for (thread &t : pool) t.join();
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Results
+    ofstream out;
+    if (const char *o = argValue(argc, argv, "--out")) {
+        out.open(o);
+        if (!out) { cerr << o << ": cannot create output file\n"; return 1; }
+    }
+    ostream &os = out.is_open() ? out : cout;
+    os << "policy,frames,faults,fault_rate\n";
+    for (const SweepJob &j : jobs)
+        os << POLICIES[j.id] << "," << j.frames << "," << j.faults << ","
+           << (ref.empty() ? 0 : (double)j.faults / ref.size()) << "\n";
+    cerr << jobs.size() << " runs of " << ref.size() << " references on " << threads
+         << " threads in " << secs << " s\n";
+    return 0;
+}
 
-            // No empty frame: choose a frame to replace optimally
-            int pos = -1;                 // Position to replace
-            int farthest = i;             // Farthest next use index found so far (start at current i)
-
-            for (int j = 0; j < fsize; j++) { // For each frame, search when its page is next used
-                int k;
-                for (k = i + 1; k < n; k++) { // Look ahead from next reference
-                    if (frames[j] == ref[k]) { // If frame's page appears at ref[k]
-                        if (k > farthest) {   // If this occurrence is later than previous farthest
-                            farthest = k;     // Update farthest
-                            pos = j;          // Candidate frame to replace
-                        }
-                        break;               // Stop searching for this frame since we found its next use
-                    }
-                }
+// Miss-ratio curve mode: page_replace --mrc --trace FILE [--opt] [--max-frames F] [--out FILE]
+int runMrc(const char *path, const PageTraceSpec &spec, int argc, char *argv[])
+{
+    const char *maxArg = argValue(argc, argv, "--max-frames");
+    long long maxFrames = maxArg ? atoll(maxArg) : LLONG_MAX;
+    bool opt = argFlag(argc, argv, "--opt");
+    if (maxFrames <= 0) {
+        cerr << "usage: page_replace --mrc --trace FILE [--opt] [--max-frames F] [--out FILE]\n";
+        return 1;
+    }
+    PageTraceReader trace(path, spec);
+    if (trace.failed) return 1;
+
+    // LRU streams the file; Optimal needs the whole string for the next uses
+    LruStackDistance lru;
+    DistanceHistogram lruHist(maxFrames), optHist(maxFrames);
+    vector<long long> ref, chunk;
+    long long refs = 0;
+    while (trace.next(chunk)) {
+        for (long long page : chunk) lruHist.add(lru.access(page));
+        if (opt) ref.insert(ref.end(), chunk.begin(), chunk.end());
+        refs += chunk.size();
+    }
+    if (trace.failed) return 1;
+    if (opt) optStackDistances(ref, min(maxFrames, lru.distinct()), optHist);
 
-                if (k == n) {               // If inner loop finished without finding the page in future
-                    pos = j;                // This frame's page is not used again; best to replace it
-                    break;                  // Break out early since this is optimal choice
-                }
+    ofstream out;
+    if (const char *o = argValue(argc, argv, "--out")) {
+        out.open(o);
+        if (!out) { cerr << o << ": cannot create output file\n"; return 1; }
+    }
+    ostream &os = out.is_open() ? out : cout;
+
+    // One row per frame count, up to the deepest hit (more frames only fault on first references)
+    vector<long long> lruFaults = lruHist.faults(), optFaults = optHist.faults();
+    long long rows = max(lruHist.depth(), optHist.depth()) + 1;
+    os << (opt ? "frames,lru_faults,lru_miss_ratio,opt_faults,opt_miss_ratio\n"
+               : "frames,lru_faults,lru_miss_ratio\n");
+    for (long long f = 1; f <= rows && f <= maxFrames; f++) {
+        long long lf = lruFaults[min(f, (long long)lruFaults.size() - 1)];
+        os << f << "," << lf << "," << (double)lf / refs;
+        if (opt) {
+            long long of = optFaults[min(f, (long long)optFaults.size() - 1)];
+            os << "," << of << "," << (double)of / refs;
+        }
+        os << "\n";
+    }
+    cerr << refs << " references, " << lru.distinct() << " distinct pages\n";
+    return 0;
+}
+
+// Approximate curve mode: page_replace --shards --trace FILE [--rate R] [--samples S] [--out FILE]
+int runShards(const char *path, const PageTraceSpec &spec, int argc, char *argv[])
+{
+    const char *rateArg = argValue(argc, argv, "--rate"), *samplesArg = argValue(argc, argv, "--samples");
+    double rate = rateArg ? atof(rateArg) : samplesArg ? 1 : 0.01;
+    long long samples = samplesArg ? atoll(samplesArg) : 0;
+    if (!(rate > 0 && rate <= 1) || samples < 0) {
+        cerr << "usage: page_replace --shards --trace FILE [--rate R] [--samples S] [--out FILE]\n";
+        return 1;
+    }
+    PageTraceReader trace(path, spec);
+    if (trace.failed) return 1;
+
+    ShardsMrc mrc(rate, samples);
+    vector<long long> chunk;
+    while (trace.next(chunk))
+        for (long long page : chunk) mrc.access(page);
+    if (trace.failed) return 1;
+
+    ofstream out;
+    if (const char *o = argValue(argc, argv, "--out")) {
+        out.open(o);
+        if (!out) { cerr << o << ": cannot create output file\n"; return 1; }
+    }
+    ostream &os = out.is_open() ? out : cout;
+
+    // One row per histogram bin (the estimate only changes every 1 / R frames). The bound
+    // treats the sampled pages as independent draws, 95% confidence.
+    long long pages = max(1LL, mrc.sampledPages());
+    double worst = 0;
+    os << "frames,lru_faults,lru_miss_ratio,error_bound\n";
+    for (const pair<double, double> &pt : mrc.curve()) {
+        double m = pt.second, bound = 1.96 * sqrt(m * (1 - m) / pages);
+        worst = max(worst, bound);
+        os << llround(pt.first) << "," << llround(m * mrc.references()) << "," << m << "," << bound << "\n";
+    }
+    cerr << mrc.references() << " references, sampling rate " << mrc.rate() << ": "
+         << mrc.sampledReferences() << " references and " << mrc.sampledPages()
+         << " pages sampled, miss ratio error bound +-" << worst << " (95%)\n";
+    return 0;
+}
+
+// Working-set mode: page_replace --wss --trace FILE --window D1,D2,... [--every N] [--out FILE]
+// One CSV row per N references (default 10000) with the mean |W(t, D)| over those references
+// for every window D; the totals (mean, peak, working-set policy faults) go to stderr.
+// The ring buffer holds the widest window, so a window is at most MAX_WINDOW references.
+const long long MAX_WINDOW = 1LL << 26;
+int runWss(const char *path, const PageTraceSpec &spec, int argc, char *argv[])
+{
+    vector<long long> windows;
+    parseCounts(argValue(argc, argv, "--window"), MAX_WINDOW, windows);
+    const char *everyArg = argValue(argc, argv, "--every");
+    long long every = everyArg ? atoll(everyArg) : 10000;
+    if (windows.empty() || every <= 0) {
+        cerr << "usage: page_replace --wss --trace FILE --window D1,D2,... [--every N] [--out FILE]\n"
+             << "       (every window D from 1 to " << MAX_WINDOW << ")\n";
+        return 1;
+    }
+    PageTraceReader trace(path, spec);
+    if (trace.failed) return 1;
+    ofstream out;
+    if (const char *o = argValue(argc, argv, "--out")) {
+        out.open(o);
+        if (!out) { cerr << o << ": cannot create output file\n"; return 1; }
+    }
+    ostream &os = out.is_open() ? out : cout;
+
+    int k = windows.size();
+    WorkingSet ws(windows);
+    vector<long long> sum(k), total(k), peak(k);  // this interval, whole trace, maximum
+    long long inInterval = 0;
+    auto row = [&]() {
+        os << ws.references();
+        for (int w = 0; w < k; w++) {
+            os << "," << (double)sum[w] / inInterval;
+            total[w] += sum[w];
+            sum[w] = 0;
+        }
+        os << "\n";
+        inInterval = 0;
+    };
+    os << "t";
+    for (long long d : windows) os << ",wss_" << d;
+    os << "\n";
+    vector<long long> chunk;
+    while (trace.next(chunk))
+        for (long long page : chunk) {
+            ws.access(page);
+            for (int w = 0; w < k; w++) {
+                sum[w] += ws.size(w);
+                peak[w] = max(peak[w], ws.size(w));
             }
+            if (++inInterval == every) row();
+        }
+    if (trace.failed) return 1;
+    if (inInterval) row();
+
+    long long refs = max(1LL, ws.references());
+    cerr << ws.references() << " references\n";
+    for (int w = 0; w < k; w++)
+        cerr << "window " << windows[w] << ": mean working set " << (double)total[w] / refs
+             << ", peak " << peak[w] << ", working-set policy faults " << ws.faults(w)
+             << " (fault rate " << (double)ws.faults(w) / refs << ")\n";
+    return 0;
+}
+
+// PFF mode: page_replace --pff T --trace FILE [--every N] [--out FILE]
+// One CSV row per N references (default 10000): the mean resident set size and the faults
+// in those references; the totals go to stderr.
+int runPff(const char *path, const PageTraceSpec &spec, int argc, char *argv[])
+{
+    long long threshold = atoll(argValue(argc, argv, "--pff"));
+    const char *everyArg = argValue(argc, argv, "--every");
+    long long every = everyArg ? atoll(everyArg) : 10000;
+    if (threshold <= 0 || every <= 0) {
+        cerr << "usage: page_replace --pff T --trace FILE [--every N] [--out FILE]\n";
+        return 1;
+    }
+    PageTraceReader trace(path, spec);
+    if (trace.failed) return 1;
+    ofstream out;
+    if (const char *o = argValue(argc, argv, "--out")) {
+        out.open(o);
+        if (!out) { cerr << o << ": cannot create output file\n"; return 1; }
+    }
+    ostream &os = out.is_open() ? out : cout;
+
+    PffPolicy pff(threshold);
+    long long sum = 0, total = 0, peak = 0, faults = 0, inInterval = 0; // faults: this interval
+    auto row = [&]() {
+        os << pff.references() << "," << (double)sum / inInterval << "," << faults << "\n";
+        total += sum;
+        sum = faults = inInterval = 0;
+    };
+    os << "t,resident,faults\n";
+    vector<long long> chunk;
+    while (trace.next(chunk))
+        for (long long page : chunk) {
+            faults += pff.access(page);
+            sum += pff.resident();
+            peak = max<long long>(peak, pff.resident());
+            if (++inInterval == every) row();
+        }
+    if (trace.failed) return 1;
+    if (inInterval) row();
+
+    long long refs = max(1LL, pff.references());
+    cerr << pff.references() << " references, " << pff.faults() << " faults (fault rate "
+         << (double)pff.faults() / refs << "), mean resident set " << (double)total / refs
+         << ", peak " << peak << "\n";
+    return 0;
+}
 
-            if (pos == -1) pos = 0;        // Fallback (shouldn't usually happen): choose frame 0
+// Multiprogramming mode: page_replace --multi --trace FILE1,FILE2,... --frames F
+//                       [--algo POLICY] [--scope local|global] [--quota Q1,Q2,...]
+//                       [--quantum Q] [--thrash X] [--out FILE]
+// Each file is one process. At degree k the first k processes share F frames: they take
+// turns (round robin, Q references each, default 100) and a process whose trace ends
+// leaves. Local replacement gives every process its own quota (--quota, or F / k each) and
+// evicts only its own pages; global replacement runs one policy over all the pages, so a
+// process can take frames from the others. Pages of different processes never coincide.
+// One CSV row per process and degree plus an "all" row; a degree whose overall fault rate
+// is more than X times (default 2) the previous one's is reported as thrashing on stderr.
+int runMulti(const char *paths, const PageTraceSpec &spec, int argc, char *argv[])
+{
+    const char *usage = "usage: page_replace --multi --trace FILE1,FILE2,... --frames F [--algo POLICY]\n"
+                        "                    [--scope local|global] [--quota Q1,Q2,...] [--quantum Q]\n"
+                        "                    [--thrash X] [--out FILE]\n";
+    const char *framesArg = argValue(argc, argv, "--frames"), *algo = argValue(argc, argv, "--algo");
+    const char *scope = argValue(argc, argv, "--scope"), *quantumArg = argValue(argc, argv, "--quantum");
+    const char *thrashArg = argValue(argc, argv, "--thrash"), *quotaArg = argValue(argc, argv, "--quota");
+    long long frames = framesArg ? atoll(framesArg) : 0, quantum = quantumArg ? atoll(quantumArg) : 100;
+    double thrash = thrashArg ? atof(thrashArg) : 2;
+    bool global = scope && string(scope) == "global";
+    vector<int> ids;
+    vector<long long> quota;
+    parseCounts(quotaArg, INT_MAX, quota);
+    if (frames <= 0 || frames > INT_MAX || quantum <= 0 || !(thrash > 1) ||
+        (scope && !global && string(scope) != "local") || (quotaArg && (quota.empty() || global)) ||
+        !parsePolicies(algo ? algo : "lru", ids) || ids.size() != 1) {
+        cerr << usage;
+        return 1;
+    }
 
-            frames[pos] = page;            // Replace chosen frame with requested page
-            pageFaults++;                  // Increment fault count
+    // The processes: every page renumbered so that no two processes share a page number
+    vector<string> names;
+    for (string s = paths; ; ) {
+        size_t c = s.find(',');
+        names.push_back(s.substr(0, c));
+        if (c == string::npos) break;
+        s = s.substr(c + 1);
+    }
+    int n = names.size();
+    if (quotaArg && (int)quota.size() != n) { cerr << "--quota: expected one quota per trace\n"; return 1; }
+    vector<vector<long long>> proc(n);
+    long long distinct = 0;
+    for (int p = 0; p < n; p++) {
+        PageTraceReader trace(names[p].c_str(), spec);
+        if (trace.failed || !readWhole(trace, proc[p])) return 1;
+        PageIndex<long long> number;
+        number.reset(1024);
+        for (long long &page : proc[p]) {
+            long long id = number.find(page);
+            if (id == -1) number.set(page, id = distinct++);
+            page = id;
         }
+    }
 
-        cout << "Total Page Faults (Optimal): " << pageFaults << "\n"; // Print result
+    ofstream out;
+    if (const char *o = argValue(argc, argv, "--out")) {
+        out.open(o);
+        if (!out) { cerr << o << ": cannot create output file\n"; return 1; }
     }
-};
+    ostream &os = out.is_open() ? out : cout;
+    os << "degree,process,frames,references,faults,fault_rate\n";
+
+    double prevRate = -1;
+    int thrashing = 0;                     // first thrashing degree, 0 = none
+    for (int k = 1; k <= n; k++) {
+        vector<long long> faults(k), share(k, global ? frames : 0);
+        long long refs = 0;
+        if (global) {
+            // The interleaved stream, cut into turns of one process each
+            struct Turn { int p; long long from, count; };
+            vector<Turn> turns;
+            vector<long long> mixed, pos(k);
+            for (bool more = true; more; ) {
+                more = false;
+                for (int p = 0; p < k; p++) {
+                    long long c = min<long long>(quantum, proc[p].size() - pos[p]);
+                    if (c == 0) continue;
+                    turns.push_back(Turn{p, (long long)mixed.size(), c});
+                    mixed.insert(mixed.end(), proc[p].begin() + pos[p], proc[p].begin() + pos[p] + c);
+                    pos[p] += c;
+                    more = true;
+                }
+            }
+            auto nextUse = make_shared<const vector<long long>>(ids[0] == 2 ? nextUses(mixed) : vector<long long>());
+            unique_ptr<PolicyRun> run = makePolicy(ids[0], frames, nextUse);
+            for (const Turn &t : turns) {
+                long long before = run->faults();
+                run->feed(mixed.data() + t.from, t.count);
+                faults[t.p] += run->faults() - before;
+            }
+        } else {
+            // Local: a process only ever evicts its own pages, so the interleaving does not
+            // change its faults and each runs alone in its quota
+            long long used = 0;
+            for (int p = 0; p < k; p++) {
+                share[p] = quotaArg ? quota[p] : frames / k + (p < frames % k);
+                used += share[p];
+            }
+            if (used > frames) {
+                cerr << "--quota: the first " << k << " quotas need " << used << " frames, more than " << frames << "\n";
+                return 1;
+            }
+            for (int p = 0; p < k; p++) {
+                if (share[p] == 0) { faults[p] = proc[p].size(); continue; } // no frame: every reference faults
+                auto nextUse = make_shared<const vector<long long>>(ids[0] == 2 ? nextUses(proc[p]) : vector<long long>());
+                unique_ptr<PolicyRun> run = makePolicy(ids[0], share[p], nextUse);
+                run->feed(proc[p].data(), proc[p].size());
+                faults[p] = run->faults();
+            }
+        }
 
+        long long total = 0;
+        for (int p = 0; p < k; p++) {
+            long long r = proc[p].size();
+            os << k << "," << names[p] << "," << share[p] << "," << r << "," << faults[p] << ","
+               << (r ? (double)faults[p] / r : 0) << "\n";
+            refs += r;
+            total += faults[p];
+        }
+        double rate = refs ? (double)total / refs : 0;
+        os << k << ",all," << frames << "," << refs << "," << total << "," << rate << "\n";
+        if (!thrashing && prevRate >= 0 && rate > thrash * prevRate) {
+            thrashing = k;
+            cerr << "thrashing at degree " << k << ": fault rate " << prevRate << " -> " << rate
+                 << "; " << frames << " frames hold " << k - 1 << " of these processes\n";
+        }
+        prevRate = rate;
+    }
+    if (!thrashing)
+        cerr << "no thrashing up to degree " << n << " in " << frames << " frames\n";
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    ios::sync_with_stdio(false);          // Faster cin/cout for long reference strings
+
+    if (const char *trace = argValue(argc, argv, "--trace")) { // Batch mode
+        PageTraceSpec spec;               // --format, --page-size, --data-only (page_trace.h)
+        if (!parsePageTrace(argc, argv, spec)) return 1;
+        if (argFlag(argc, argv, "--multi")) return runMulti(trace, spec, argc, argv);
+        if (argFlag(argc, argv, "--mrc")) return runMrc(trace, spec, argc, argv);
+        if (argFlag(argc, argv, "--shards")) return runShards(trace, spec, argc, argv);
+        if (argFlag(argc, argv, "--sweep")) return runSweep(trace, spec, argc, argv);
+        if (argFlag(argc, argv, "--wss")) return runWss(trace, spec, argc, argv);
+        if (argValue(argc, argv, "--pff")) return runPff(trace, spec, argc, argv);
+        const char *frames = argValue(argc, argv, "--frames"), *algo = argValue(argc, argv, "--algo");
+        TlbSpec tlb;                      // --tlb: translation model in front (tlb.h)
+        tlb.pageShift = spec.pageShift;
+        if (argFlag(argc, argv, "--tlb") && !parseTlb(argc, argv, tlb)) return 1;
+        return runTrace(trace, spec, frames ? frames : "0", algo ? algo : "",
+                        argFlag(argc, argv, "--tlb") ? &tlb : nullptr);
+    }
 
-int main() {
     VirtualMemory vm;                     // Create VirtualMemory object
 
     vm.enterInput();                      // Get user input for frames and reference string
 
-    cout << "\nChoose Algorithm:\n1 FIFO\n2 LRU\n3 Optimal\nEnter: "; // Prompt for algorithm choice
+    cout << "\nChoose Algorithm:\n1 FIFO\n2 LRU\n3 Optimal\n4 CLOCK\n5 LFU\n6 2Q\n7 ARC\n8 LIRS\nEnter: "; // Prompt for algorithm choice
     int ch;                               // Variable to store user choice
     cin >> ch;                            // Read choice
 
-    if (ch == 1) vm.FIFO();               // Run FIFO if chosen
-    if (ch == 2) vm.LRU();                // Run LRU if chosen
-    if (ch == 3) vm.Optimal();            // Run Optimal if chosen
+    int f = vm.fsize;
+    if (ch == 1) vm.simulate(FifoPolicy(f));           // Run FIFO if chosen
+    if (ch == 2) vm.simulate(LruPolicy(f));            // Run LRU if chosen
+    if (ch == 3) vm.simulate(OptimalPolicy(f, vm.ref)); // Run Optimal if chosen
+    if (ch == 4) vm.simulate(ClockPolicy(f));          // Second chance
+    if (ch == 5) vm.simulate(LfuPolicy(f));            // Least frequently used
+    if (ch == 6) vm.simulate(TwoQPolicy(f));           // 2Q
+    if (ch == 7) vm.simulate(ArcPolicy(f));            // Adaptive Replacement Cache
+    if (ch == 8) vm.simulate(LirsPolicy(f));           // LIRS
 
     return 0;                             // Exit program
 }
@@ -0,0 +1,205 @@
+/*
+    TOPIC: Page Traces - reference strings for page_replace.cpp from files
+
+    WHAT IS THIS FILE?
+    - page_replace.cpp can prompt for a reference string, but real memory access traces
+      have millions to billions of references. With --trace FILE it reads them from a file
+      instead, through PageTraceReader, in one of the formats below (--format).
+
+    TRACE FORMATS
+    - pages  : text page numbers separated by spaces, commas or newlines; '#' starts a
+               comment that runs to the end of the line. (The default.)
+    - addr   : binary, raw virtual addresses as 64-bit little-endian integers, 8 bytes each,
+               no header.
+    - lackey : the text that valgrind --tool=lackey --trace-mem=yes writes:
+                   I  04016a0,3        instruction fetch at 0x04016a0, 3 bytes
+                    L 7ff000398,8      load
+                    S 04222cac,4       store
+                    M 0421f8,4         modify (load and store: one reference)
+               Other lines (valgrind's ==pid== messages, program output) are skipped.
+               --data-only skips the instruction fetches. Path "-" reads standard input,
+               so valgrind can be piped straight in.
+    - addr and lackey addresses become page numbers by dividing by the page size:
+      --page-size 4K (the default), 2M for huge pages, or any power of two (K, M, G suffixes
+      or plain bytes). An access that crosses a page boundary references every page it touches.
+
+    HOW IS IT FAST?
+    - pages and addr files are memory-mapped (MappedFile, proc_trace.h) and parsed in place;
+      lackey is read through a 1 MB buffer, which also works on a pipe.
+    - The trace is never loaded whole: next() hands out the page numbers in chunks of 64K,
+      small enough to stay in cache while every policy consumes them.
+*/
+
+#ifndef PAGE_TRACE_H
+#define PAGE_TRACE_H
+
+#include <vector>       // std::vector
+#include <memory>       // std::unique_ptr
+#include <cstdio>       // std::FILE, std::fopen, std::fread
+#include <algorithm>    // std::min
+#include <cctype>       // std::isxdigit
+#include <cstring>      // std::strcmp, std::memchr, std::memmove, std::memcpy
+#include <cstdlib>      // std::strtoull
+#include <cstdint>      // std::uint64_t
+#include <iostream>     // std::cerr
+#include "proc_trace.h" // MappedFile, argValue(), argFlag()
+
+enum PageTraceFormat { TRACE_PAGES, TRACE_ADDR, TRACE_LACKEY };
+
+struct PageTraceSpec {
+    PageTraceFormat format = TRACE_PAGES;
+    int pageShift = 12;                    // page size = 2^pageShift bytes (4K)
+    bool dataOnly = false;                 // lackey: skip instruction fetches
+};
+
+// Reads a page trace front to back in chunks, in memory independent of the trace length
+class PageTraceReader {
+public:
+    static const size_t CHUNK = 1 << 16;   // page numbers per chunk
+    bool failed = false;                   // set when the file cannot be read or is malformed
+
+    PageTraceReader(const char *p, const PageTraceSpec &spec) : path(p), spec(spec) {
+        if (spec.format == TRACE_LACKEY) {
+            in = std::strcmp(p, "-") == 0 ? stdin : std::fopen(p, "rb");
+            if (!in) { std::cerr << p << ": cannot open trace file\n"; failed = true; }
+            buf.resize(1 << 20);
+            return;
+        }
+        file.reset(new MappedFile(p));
+        if (!file->ok) { std::cerr << p << ": cannot open trace file\n"; failed = true; return; }
+        pos = file->data;
+        end = file->data + file->size;
+        if (spec.format == TRACE_ADDR && file->size % 8 != 0) {
+            std::cerr << p << ": address trace is not a whole number of 8-byte addresses\n";
+            failed = true;
+        }
+    }
+    ~PageTraceReader() { if (in && in != stdin) std::fclose(in); }
+
+    // Next chunk of page numbers: false at the end of the trace (or on error, with failed set)
+    bool next(std::vector<long long> &chunk) {
+        chunk.clear();
+        if (failed) return false;
+        if (spec.format == TRACE_PAGES) readPages(chunk);
+        else if (spec.format == TRACE_ADDR) readAddresses(chunk);
+        else readLackey(chunk);
+        return !failed && !chunk.empty();
+    }
+
+private:
+    const char *path;                      // for error messages
+    PageTraceSpec spec;
+    std::unique_ptr<MappedFile> file;      // pages, addr: the mapped file
+    const char *pos = nullptr, *end = nullptr; // unread part of it
+    long long line = 1;                    // current line (pages)
+    std::FILE *in = nullptr;               // lackey input
+    std::vector<char> buf;                 // lackey: buf[head .. tail) not parsed yet
+    size_t head = 0, tail = 0;
+    bool eof = false;
+
+    void readPages(std::vector<long long> &chunk) {
+        while (pos < end && chunk.size() < CHUNK) {
+            char c = *pos;
+            if (c == '\n') { line++; pos++; continue; }
+            if (c == ' ' || c == '\t' || c == '\r' || c == ',') { pos++; continue; }
+            if (c == '#') {                // comment: skip to the end of the line
+                while (pos < end && *pos != '\n') pos++;
+                continue;
+            }
+            if (c < '0' || c > '9') {
+                std::cerr << path << ":" << line << ": expected a page number\n";
+                failed = true;
+                return;
+            }
+            long long page = 0;
+            while (pos < end && *pos >= '0' && *pos <= '9') page = page * 10 + (*pos++ - '0');
+            chunk.push_back(page);
+        }
+    }
+
+    void readAddresses(std::vector<long long> &chunk) {
+        size_t count = std::min<size_t>(CHUNK, (end - pos) / 8);
+        chunk.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            std::uint64_t a;
+            std::memcpy(&a, pos + 8 * i, 8); // the mapping need not be 8-byte aligned
+            chunk[i] = a >> spec.pageShift;
+        }
+        pos += 8 * count;
+    }
+
+    void readLackey(std::vector<long long> &chunk) {
+        const char *b, *e;
+        while (chunk.size() < CHUNK && getLine(b, e)) {
+            // "I  ADDR,SIZE" or " K ADDR,SIZE" with K = L, S or M; anything else is skipped
+            while (b < e && *b == ' ') b++;
+            if (b == e || (*b != 'I' && *b != 'L' && *b != 'S' && *b != 'M')) continue;
+            if (*b == 'I' && spec.dataOnly) continue;
+            b++;
+            if (b == e || *b != ' ') continue;
+            while (b < e && *b == ' ') b++;
+            std::uint64_t addr = 0, size = 0;
+            const char *h = b;
+            for (; b < e && std::isxdigit((unsigned char)*b); b++)
+                addr = addr * 16 + (*b <= '9' ? *b - '0' : (*b | 0x20) - 'a' + 10);
+            if (b == h || b == e || *b != ',') continue;
+            for (b++; b < e && *b >= '0' && *b <= '9'; b++) size = size * 10 + (*b - '0');
+            std::uint64_t first = addr >> spec.pageShift, last = (addr + (size ? size - 1 : 0)) >> spec.pageShift;
+            for (std::uint64_t page = first; page <= last; page++) chunk.push_back(page);
+        }
+    }
+
+    // Next line of the lackey input as [b, e), without the newline
+    bool getLine(const char *&b, const char *&e) {
+        for (;;) {
+            char *nl = (char *)std::memchr(buf.data() + head, '\n', tail - head);
+            if (nl || (eof && head < tail)) {
+                b = buf.data() + head;
+                e = nl ? nl : buf.data() + tail;
+                head = nl ? nl - buf.data() + 1 : tail;
+                return true;
+            }
+            if (eof) return false;
+            std::memmove(buf.data(), buf.data() + head, tail - head); // keep the partial line
+            tail -= head;
+            head = 0;
+            if (tail == buf.size()) buf.resize(2 * buf.size());       // a very long line
+            size_t got = std::fread(buf.data() + tail, 1, buf.size() - tail, in);
+            tail += got;
+            if (got == 0) eof = true;
+        }
+    }
+};
+
+// Page size in bytes ("4K", "2M", "1G" or a plain number) as a power of two; -1 if invalid
+inline int parsePageShift(const char *s)
+{
+    char *end;
+    unsigned long long v = std::strtoull(s, &end, 10);
+    if (*end == 'K' || *end == 'k') { v <<= 10; end++; }
+    else if (*end == 'M' || *end == 'm') { v <<= 20; end++; }
+    else if (*end == 'G' || *end == 'g') { v <<= 30; end++; }
+    if (end == s || *end || v == 0 || (v & (v - 1))) return -1;
+    int shift = 0;
+    while ((1ULL << shift) < v) shift++;
+    return shift;
+}
+
+// Read --format, --page-size and --data-only from the command line; false on errors
+inline bool parsePageTrace(int argc, char *argv[], PageTraceSpec &spec)
+{
+    if (const char *s = argValue(argc, argv, "--format")) {
+        if (std::strcmp(s, "pages") == 0) spec.format = TRACE_PAGES;
+        else if (std::strcmp(s, "addr") == 0) spec.format = TRACE_ADDR;
+        else if (std::strcmp(s, "lackey") == 0) spec.format = TRACE_LACKEY;
+        else { std::cerr << "--format: expected pages, addr or lackey\n"; return false; }
+    }
+    if (const char *s = argValue(argc, argv, "--page-size")) {
+        spec.pageShift = parsePageShift(s);
+        if (spec.pageShift < 0) { std::cerr << "--page-size: expected a power of two, e.g. 4K or 2M\n"; return false; }
+    }
+    spec.dataOnly = argFlag(argc, argv, "--data-only");
+    return true;
+}
+
+#endif
@@ -7,65 +7,75 @@
     - This implementation is non-preemptive: once a process starts, it runs to completion.
 
     WHAT DOES THIS PROGRAM DO?
-    - Reads n processes with Arrival Time (AT), Burst Time (BT), and Priority (PR).
+    - Reads n processes with Arrival Time (AT), Burst Time (BT), and Priority (PR),
+      or reads them all from a trace file (priority --trace FILE, see proc_trace.h).
     - Simulates non-preemptive priority scheduling (chooses the ready process with smallest PR).
     - Computes Completion Time (CT), Turn-Around Time (TAT), Waiting Time (WT).
     - Prints per-process times and average WT and TAT.
+    - --stats also prints waiting, turn-around and response time percentiles, context switches
+      and preemptions; --timeline FILE saves the Gantt chart (see sched_probe.h).
+
+    HOW?
+    - Uses the shared non-preemptive engine in sched_engines.h with key = priority:
+      arrived processes go into a min-heap and idle gaps are skipped, so it runs in O(n log n).
 */
 
-#include <iostream>     // For cin, cout
-using namespace std;    // Use the standard namespace to avoid prefixing std::
+#include <iostream>         // For cin, cout
+#include <vector>           // For vector (process table of any size)
+#include "sched_engines.h"  // For nonPreemptive()
+#include "proc_trace.h"     // For ProcessTable, loadTrace()
+using namespace std;        // Use the standard namespace to avoid prefixing std::
 
-int main()
+int main(int argc, char *argv[])
 {
-    int n;                                 // Number of processes
-    cout << "Enter number of processes : "; // Prompt user
-    cin >> n;                              // Read number of processes
+    ios::sync_with_stdio(false);           // Faster cin/cout for large inputs
 
-    int pid[50], art[50], bt[50], pr[50];  // pid = process id, art = arrival time, bt = burst time, pr = priority
-    int ct[50], tat[50], wt[50], done[50] = {0}; // ct = completion time, tat = turnaround, wt = waiting, done = finished flag
+    ProcessTable pt;                       // Process table: pt.art, pt.bt, pt.pr columns
+    const char *trace = argValue(argc, argv, "--trace");
+    if (trace) {                           // Batch mode: every process comes from the trace file
+        if (!loadTrace(trace, pt)) return 1;
+        if (!pt.hasPriority()) {
+            cerr << trace << ": trace has no priority column\n";
+            return 1;
+        }
+    } else {
+        int n;                                 // Number of processes
+        cout << "Enter number of processes : "; // Prompt user
+        cin >> n;                              // Read number of processes
+        pt.art.resize(n);
+        pt.bt.resize(n);
+        pt.pr.resize(n);
 
-    for(int i = 0; i < n; i++){            // Loop to read process data
-        pid[i] = i + 1;                    // Assign process ID (P1, P2, ...)
-        cout << "P" << pid[i] << " At BT Priority : "; // Prompt for AT, BT, PR
-        cin >> art[i] >> bt[i] >> pr[i];   // Read arrival time, burst time, and priority
+        for(int i = 0; i < n; i++){            // Loop to read process data
+            cout << "P" << i + 1 << " At BT Priority : "; // Prompt for AT, BT, PR
+            cin >> pt.art[i] >> pt.bt[i] >> pt.pr[i]; // Read arrival time, burst time, and priority
+        }
     }
 
-    int time = 0, completed = 0;           // time = current time, completed = number of finished processes
+    int n = pt.size();                     // Number of processes
+    const vector<long long> &art = pt.art, &bt = pt.bt, &pr = pt.pr; // Short names for the columns
+    vector<long long> ct(n), tat(n), wt(n); // ct = completion time, tat = turnaround, wt = waiting
 
-    while (completed < n) {                // Loop until all processes are completed
-        int idx = -1;                      // idx = index of chosen process to run next
-        int best = 999;                    // best = best priority found (lower is better); initialize large
+    const char *timeline = argValue(argc, argv, "--timeline"); // binary Gantt chart (sched_probe.h)
+    bool stats = argFlag(argc, argv, "--stats");              // print latency percentiles too
+    SchedProbe probe(stats || timeline ? n : 0, 1, timeline); // sees every run when enabled
+    if (!probe.ok()) return 1;
 
-        for (int i = 0; i < n; i++) {      // Search among all processes for ready and not-done ones
-            if (!done[i] && art[i] <= time) { // Consider only processes that have arrived and not finished
-                if (pr[i] < best) {        // If this process has a higher priority (smaller number)
-                    best = pr[i];          // Update best priority
-                    idx = i;               // Update chosen process index
-                }
-            }
-        }
+    if (stats || timeline) nonPreemptive(art, bt, pr, ct, probe);
+    else nonPreemptive(art, bt, pr, ct);   // Priority: the selection key is the priority value
 
-        if (idx == -1) {                   // If no process is ready at current time
-            time++;                        // Advance time (CPU idle)
-            continue;                      // Retry finding a process
-        }
-
-        time += bt[idx];                    // Execute chosen process non-preemptively: advance time by its burst time
-        ct[idx] = time;                     // Completion time for chosen process
-        tat[idx] = ct[idx] - art[idx];      // Turn-Around Time = CT - Arrival Time
-        wt[idx] = tat[idx] - bt[idx];       // Waiting Time = TAT - Burst Time
-        done[idx] = 1;                      // Mark this process as finished
-        completed++;                        // Increment finished count
+    for (int i = 0; i < n; i++) {
+        tat[i] = ct[i] - art[i];           // Turn-Around Time = CT - Arrival Time
+        wt[i] = tat[i] - bt[i];            // Waiting Time = TAT - Burst Time
     }
 
     cout << "\nPID\tAT\tBT\tPR\tCT\tTAT\tWT\n"; // Print header for results
     for (int i = 0; i < n; i++) {            // Print per-process values
-        cout << "P" << pid[i] << "\t" << art[i] << "\t" << bt[i] << "\t" << pr[i] << "\t"
-             << ct[i] << "\t" << tat[i] << "\t" << wt[i] << endl;
+        cout << "P" << i + 1 << "\t" << art[i] << "\t" << bt[i] << "\t" << pr[i] << "\t"
+             << ct[i] << "\t" << tat[i] << "\t" << wt[i] << "\n";
     }
 
-    float total_wt = 0, total_tat = 0;       // Accumulators for averages
+    double total_wt = 0, total_tat = 0;      // Accumulators for averages
     for (int i = 0; i < n; i++) {            // Sum waiting and turnaround times
         total_wt += wt[i];
         total_tat += tat[i];
@@ -73,6 +83,10 @@ int main()
 
     cout << "\nAverage Waiting Time     : " << total_wt / n << endl;      // Print average waiting time
     cout << "Average Turn-Around Time : " << total_tat / n << endl;      // Print average TAT
+    if (stats) {                                 // latency percentiles, context switches, preemptions
+        probe.finish(art, bt, ct);
+        probe.report(cout);
+    }
 
     return 0;                                // Normal program termination
 }
@@ -7,82 +7,105 @@
     - Preemptive means a running process can be interrupted if a higher-priority process arrives.
 
     WHAT DOES THIS PROGRAM DO?
-    - Reads n processes with Arrival Time (AT), Burst Time (BT), and Priority (PR).
-    - Simulates preemptive priority scheduling using a unit-time simulation loop.
+    - Reads n processes with Arrival Time (AT), Burst Time (BT), and Priority (PR),
+      or reads them all from a trace file (priority_prem --trace FILE, see proc_trace.h).
+    - Simulates preemptive priority scheduling as a discrete-event simulation
+      (priorityPreemptive() in sched_engines.h).
     - Computes Completion Time (CT), Turn-Around Time (TAT), Waiting Time (WT).
     - Prints per-process times and average WT and TAT.
+    - --stats also prints waiting, turn-around and response time percentiles, context switches
+      and preemptions; --timeline FILE saves the Gantt chart (see sched_probe.h).
+
+    HOW IS IT FAST?
+    - Decisions are only made at events: an arrival, a completion, or (with aging) the moment
+      a waiting process's aged priority overtakes the running one.
+    - Waiting processes sit in an indexed min-heap, so each decision costs O(log n).
+
+    WHAT IS AGING? (optional: run with --aging A)
+    - Low-priority jobs can starve if high-priority jobs keep arriving.
+    - With aging, a waiting process gains 1 priority level for every A time units it waits
+      in the ready queue:  effective PR = PR - floor(waited / A).
+    - A process keeps the aged priority it was dispatched with while it runs; once preempted
+      it waits again from its original PR.
+    - Trick: store key = PR*A + (time it became ready). Then effective PR = ceil((key - time) / A),
+      so ordering by key never changes while processes wait and the heap never needs re-keying.
 */
 
 #include <iostream>     // for cin, cout
+#include <vector>       // for vector (process table of any size)
+#include <cstdlib>      // for atoll
+#include "proc_trace.h" // for ProcessTable, loadTrace()
+#include "sched_engines.h" // for priorityPreemptive()
 using namespace std;    // bring std names into global namespace
 
-int main() {
-    int n;                                     // number of processes
-    cout << "Enter number of processes : ";    // prompt user
-    cin >> n;                                  // read number of processes
-
-    int pid[50], art[50], bt[50], pr[50];      // pid: process id, art: arrival times, bt: burst times, pr: priorities
-    int ct[50], tat[50], wt[50];               // ct: completion times, tat: turnaround times, wt: waiting times
-    int rem[50];                               // rem: remaining burst time for each process
-
-    // Input block: read AT, BT, PR for each process and initialize remaining time
-    for(int i = 0; i < n; i++) {
-        pid[i] = i + 1;                        // assign process id P1..Pn
-        cout << "P" << pid[i] << " AT BT Priority : "; // prompt for AT, BT, PR of process i
-        cin >> art[i] >> bt[i] >> pr[i];      // read arrival time, burst time, priority
-        rem[i] = bt[i];                       // initially remaining time equals burst time
-    }
-
-    int time = 0, completed = 0;              // time: current simulation time, completed: number of finished processes
-    float sumwt = 0, sumtat = 0;              // accumulators for average waiting and turnaround times
-
-    // Main simulation loop: run until all processes are completed
-    while (completed < n) {
+int main(int argc, char *argv[]) {
+    ios::sync_with_stdio(false);               // faster cin/cout for large inputs
 
-        int idx = -1;                         // index of selected process to run in this time unit
-        int bestPriority = 9999;              // bestPriority holds the smallest priority value seen (smaller = better)
+    long long aging = 0;                       // aging interval (0 = no aging)
+    if (const char *a = argValue(argc, argv, "--aging"))
+        aging = atoll(a);                      // --aging A: 1 priority level per A time units waited
+    if (aging < 0) {
+        cerr << "usage: priority_prem [--aging A] [--trace FILE] [--stats] [--timeline FILE]\n";
+        return 1;
+    }
 
-        // Find the ready process with the highest priority (smallest pr[]) and rem>0
-        for (int i = 0; i < n; i++) {
-            if (art[i] <= time && rem[i] > 0) {   // process has arrived and still needs CPU
-                if (pr[i] < bestPriority) {      // if this process has higher priority than previous best
-                    bestPriority = pr[i];        // update bestPriority
-                    idx = i;                     // update index of chosen process
-                }
-            }
+    ProcessTable pt;                           // process table: pt.art, pt.bt, pt.pr columns
+    const char *trace = argValue(argc, argv, "--trace");
+    if (trace) {                               // batch mode: every process comes from the trace file
+        if (!loadTrace(trace, pt)) return 1;
+        if (!pt.hasPriority()) {
+            cerr << trace << ": trace has no priority column\n";
+            return 1;
         }
-
-        if (idx == -1) {                       // if no process is ready at this time (CPU idle)
-            time++;                            // advance time by 1 unit and continue
-            continue;
+    } else {
+        int n;                                     // number of processes
+        cout << "Enter number of processes : ";    // prompt user
+        cin >> n;                                  // read number of processes
+        pt.art.resize(n);
+        pt.bt.resize(n);
+        pt.pr.resize(n);
+
+        // Input block: read AT, BT, PR for each process
+        for(int i = 0; i < n; i++) {
+            cout << "P" << i + 1 << " AT BT Priority : "; // prompt for AT, BT, PR of process i
+            cin >> pt.art[i] >> pt.bt[i] >> pt.pr[i]; // read arrival time, burst time, priority
         }
+    }
 
-        // Run selected process for one time unit (preemptive simulation)
-        rem[idx]--;                            // decrease remaining burst time by 1
-        time++;                                // advance the current time by 1
+    int n = pt.size();                         // number of processes
+    const vector<long long> &art = pt.art, &bt = pt.bt, &pr = pt.pr; // short names for the columns
+    vector<long long> ct(n), tat(n), wt(n);    // ct: completion times, tat: turnaround times, wt: waiting times
 
-        // If process completes (remaining becomes 0), calculate its metrics
-        if (rem[idx] == 0) {
-            ct[idx] = time;                    // completion time is current time
-            tat[idx] = ct[idx] - art[idx];     // turnaround time = completion - arrival
-            wt[idx] = tat[idx] - bt[idx];      // waiting time = turnaround - burst
-            completed++;                       // one more process finished
+    const char *timeline = argValue(argc, argv, "--timeline"); // binary Gantt chart (sched_probe.h)
+    bool stats = argFlag(argc, argv, "--stats");              // print latency percentiles too
+    SchedProbe probe(stats || timeline ? n : 0, 1, timeline); // sees every run when enabled
+    if (!probe.ok()) return 1;
 
-            sumwt += wt[idx];                  // add to total waiting time accumulator
-            sumtat += tat[idx];                // add to total turnaround time accumulator
-        }
+    if (stats || timeline) priorityPreemptive(art, bt, pr, aging, ct, probe);
+    else priorityPreemptive(art, bt, pr, aging, ct); // run the simulation, fills ct[]
+
+    double sumwt = 0, sumtat = 0;              // accumulators for average waiting and turnaround times
+    for (int i = 0; i < n; i++) {
+        tat[i] = ct[i] - art[i];               // turnaround time = completion - arrival
+        wt[i] = tat[i] - bt[i];                // waiting time = turnaround - burst
+        sumwt += wt[i];                        // add to total waiting time accumulator
+        sumtat += tat[i];                      // add to total turnaround time accumulator
     }
 
     // Print table header and results for each process
     cout << "\nPID\tBT\tCT\tTAT\tWT\n";
     for(int i = 0; i < n; i++){
-        cout << "P" << pid[i] << "\t" << bt[i] << "\t"
-             << ct[i] << "\t" << tat[i] << "\t" << wt[i] << endl;
+        cout << "P" << i + 1 << "\t" << bt[i] << "\t"
+             << ct[i] << "\t" << tat[i] << "\t" << wt[i] << "\n";
     }
 
     // Print average waiting time and average turnaround time
     cout << "\nAverage Waiting Time     : " << sumwt / n << endl;
     cout << "Average Turn-Around Time : " << sumtat / n << endl;
+    if (stats) {                                 // latency percentiles, context switches, preemptions
+        probe.finish(art, bt, ct);
+        probe.report(cout);
+    }
 
     return 0;                                // successful termination
 }
@@ -0,0 +1,342 @@
+/*
+    TOPIC: Process Traces - batch input for the CPU scheduling programs
+
+    WHAT IS THIS FILE?
+    - Every scheduler in this folder can prompt for its processes one by one with cin.
+    - For large workloads, they can instead read a whole trace file: prog --trace FILE
+    - The trace is loaded into a ProcessTable: one array per column (structure of arrays),
+      of any size, which the scheduling engines take directly.
+
+    TRACE FORMATS
+    - Text (CSV): one process per line, values separated by commas or spaces.
+          AT,BT          arrival time and burst time
+          AT,BT,PR       arrival time, burst time and priority
+          BT             burst time only (every process arrives at time 0)
+      Blank lines, lines starting with '#' and a header line such as "at,bt,pr" are skipped.
+      The same numbers you would type at the prompts also work as a trace (minus the count).
+    - Binary: a 16-byte header followed by the columns, each an array of 64-bit integers:
+          "PTR1"        4-byte magic
+          uint32 cols   2 (AT,BT) or 3 (AT,BT,PR)
+          uint64 n      number of processes
+          int64 AT[n], int64 BT[n], [int64 PR[n]]
+      Loading it is one copy per column. trace_convert.cpp turns a text trace into this form.
+    - AT and BT must not be negative (a priority may be); a trace that breaks this is rejected.
+
+    HOW IS IT FAST?
+    - Files are memory-mapped (mmap) and parsed in place: no iostream, no per-line allocation.
+    - TraceReader streams a trace one process at a time in constant memory instead.
+*/
+
+#ifndef PROC_TRACE_H
+#define PROC_TRACE_H
+
+#include <vector>       // std::vector
+#include <cstdio>       // std::FILE, std::fopen, std::fwrite
+#include <cstring>      // std::memcmp, std::memcpy, std::strcmp
+#include <cstdint>      // std::uint32_t, std::uint64_t, std::int64_t
+#include <iostream>     // std::cerr
+#include <fcntl.h>      // open()
+#include <sys/mman.h>   // mmap(), munmap()
+#include <sys/stat.h>   // fstat()
+#include <unistd.h>     // close()
+
+// The process table: column i of every vector describes process P(i+1)
+struct ProcessTable {
+    std::vector<long long> art;   // arrival times
+    std::vector<long long> bt;    // burst times
+    std::vector<long long> pr;    // priorities (empty if the trace has none)
+
+    int size() const { return bt.size(); }
+    bool hasPriority() const { return !pr.empty(); }
+};
+
+// Value of command-line option "name" (e.g. --trace FILE), or nullptr if it is not given
+inline const char *argValue(int argc, char *argv[], const char *name)
+{
+    for (int a = 1; a + 1 < argc; a++)
+        if (std::strcmp(argv[a], name) == 0)
+            return argv[a + 1];
+    return nullptr;
+}
+
+// True if the command-line switch "name" (e.g. --stats) is given
+inline bool argFlag(int argc, char *argv[], const char *name)
+{
+    for (int a = 1; a < argc; a++)
+        if (std::strcmp(argv[a], name) == 0)
+            return true;
+    return false;
+}
+
+// Read-only memory mapping of a whole file, unmapped when it goes out of scope
+struct MappedFile {
+    const char *data = nullptr;   // file contents
+    size_t size = 0;              // file length in bytes
+    bool ok = false;              // false if the file could not be opened
+
+    MappedFile(const char *path) {
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (fstat(fd, &st) == 0) {
+            size = st.st_size;
+            if (size == 0) ok = true; // empty file: nothing to map
+            else {
+                void *p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p != MAP_FAILED) {
+                    madvise(p, size, MADV_SEQUENTIAL); // we read it front to back once
+                    data = (const char *)p;
+                    ok = true;
+                }
+            }
+        }
+        close(fd);
+    }
+    ~MappedFile() { if (data) munmap((void *)data, size); }
+};
+
+// Binary trace header (see the top of this file)
+struct TraceHeader {
+    char magic[4];                // "PTR1"
+    std::uint32_t cols;           // 2 or 3
+    std::uint64_t n;              // number of processes
+};
+
+// Load the columns of a binary trace
+inline bool loadBinaryTrace(const MappedFile &f, const char *path, ProcessTable &t)
+{
+    TraceHeader h;
+    std::memcpy(&h, f.data, sizeof h);
+    std::uint64_t record = h.cols * sizeof(std::int64_t); // bytes per process, over all columns
+    if ((h.cols != 2 && h.cols != 3) || h.n > (f.size - sizeof h) / record ||
+        f.size - sizeof h != h.n * record) {             // no overflow: h.n * record <= f.size
+        std::cerr << path << ": corrupt binary trace\n";
+        return false;
+    }
+    const std::int64_t *col = (const std::int64_t *)(f.data + sizeof h);
+    for (std::uint64_t i = 0; i < 2 * h.n; i++)          // AT and BT columns
+        if (col[i] < 0) {
+            std::cerr << path << ": process " << i % h.n + 1 << " has a negative AT or BT\n";
+            return false;
+        }
+    t.art.assign(col, col + h.n);                        // AT column
+    t.bt.assign(col + h.n, col + 2 * h.n);               // BT column
+    if (h.cols == 3) t.pr.assign(col + 2 * h.n, col + 3 * h.n); // PR column
+    else t.pr.clear();
+    return true;
+}
+
+// Parse one text line [q, eol) into v[]. Returns the number of values (1 to 3), 0 for a line
+// to skip (blank, comment, or a header on the first line), or -1 if the line is malformed.
+inline int parseTraceLine(const char *q, const char *eol, bool firstLine, long long v[3])
+{
+    while (q < eol && (*q == ' ' || *q == '\t' || *q == '\r')) q++;
+    if (q == eol || *q == '#') return 0;                                 // blank line or comment
+    if (firstLine && !(*q == '-' || (*q >= '0' && *q <= '9'))) return 0; // header line
+
+    int k = 0;
+    while (q < eol) {
+        bool neg = (*q == '-');
+        if (neg) q++;
+        if (q == eol || *q < '0' || *q > '9' || k == 3) return -1;
+        long long x = 0;
+        while (q < eol && *q >= '0' && *q <= '9') x = x * 10 + (*q++ - '0');
+        v[k++] = neg ? -x : x;
+        while (q < eol && (*q == ',' || *q == ' ' || *q == '\t' || *q == '\r')) q++;
+    }
+    return k;
+}
+
+// Parse a text trace in place
+inline bool loadTextTrace(const MappedFile &f, const char *path, ProcessTable &t)
+{
+    const char *p = f.data, *end = f.data + f.size;
+    int cols = 0;                              // values per line, fixed by the first data line
+    long long line = 0;                        // line number for error messages
+    t.art.clear(); t.bt.clear(); t.pr.clear();
+    t.bt.reserve(f.size / 8);                  // rough guess: a few bytes per value
+
+    while (p < end) {
+        line++;
+        const char *eol = (const char *)std::memchr(p, '\n', end - p);
+        if (!eol) eol = end;
+
+        long long v[3];                        // values on this line
+        int k = parseTraceLine(p, eol, line == 1, v);
+        if (k < 0 || (k > 0 && cols > 0 && k != cols)) {
+            std::cerr << path << ":" << line << ": malformed trace line\n";
+            return false;
+        }
+        if (k > 0 && (v[0] < 0 || (k > 1 && v[1] < 0))) {  // AT and BT; a priority may be negative
+            std::cerr << path << ":" << line << ": negative AT or BT\n";
+            return false;
+        }
+        if (k > 0) {
+            cols = k;
+            if (cols == 1) { t.art.push_back(0); t.bt.push_back(v[0]); }
+            else {
+                t.art.push_back(v[0]);
+                t.bt.push_back(v[1]);
+                if (cols == 3) t.pr.push_back(v[2]);
+            }
+        }
+        p = eol + 1;
+    }
+    return true;
+}
+
+// Load a trace file (text or binary, detected from the first bytes) into t.
+// A trace without any process is an error too: there is nothing to schedule or average.
+inline bool loadTrace(const char *path, ProcessTable &t)
+{
+    MappedFile f(path);
+    if (!f.ok) {
+        std::cerr << path << ": cannot open trace file\n";
+        return false;
+    }
+    bool ok = f.size >= sizeof(TraceHeader) && std::memcmp(f.data, "PTR1", 4) == 0
+                  ? loadBinaryTrace(f, path, t) : loadTextTrace(f, path, t);
+    if (ok && t.size() == 0) {
+        std::cerr << path << ": no processes\n";
+        return false;
+    }
+    return ok;
+}
+
+// Write t as a binary trace
+inline bool saveBinaryTrace(const char *path, const ProcessTable &t)
+{
+    std::FILE *out = std::fopen(path, "wb");
+    if (!out) {
+        std::cerr << path << ": cannot create trace file\n";
+        return false;
+    }
+    TraceHeader h = {{'P', 'T', 'R', '1'}, t.hasPriority() ? 3u : 2u, (std::uint64_t)t.size()};
+    std::fwrite(&h, sizeof h, 1, out);
+    std::fwrite(t.art.data(), sizeof(long long), t.size(), out);
+    std::fwrite(t.bt.data(), sizeof(long long), t.size(), out);
+    if (t.hasPriority()) std::fwrite(t.pr.data(), sizeof(long long), t.size(), out);
+    return std::fclose(out) == 0;
+}
+
+// Reads a trace one process at a time in constant memory, for traces too big to load.
+// path "-" reads a text trace from standard input.
+class TraceReader {
+public:
+    bool failed = false;          // set when the file cannot be opened or a line is malformed
+    long long line = 0;           // current line (text) or record (binary) number
+
+    TraceReader(const char *p) : path(p) {
+        in = std::strcmp(p, "-") == 0 ? stdin : std::fopen(p, "rb");
+        if (!in) { std::cerr << p << ": cannot open trace file\n"; failed = true; return; }
+
+        TraceHeader h;
+        if (in != stdin && std::fread(&h, sizeof h, 1, in) == 1 && std::memcmp(h.magic, "PTR1", 4) == 0) {
+            // Binary: one stdio stream per column, each positioned at the start of its column
+            binary = true;
+            col[0] = in;
+            in = nullptr;
+            if (h.cols != 2 && h.cols != 3) {
+                std::cerr << p << ": corrupt binary trace\n";
+                failed = true;
+                return;
+            }
+            left = h.n;
+            cols = h.cols;
+            for (int c = 1; c < cols; c++) {
+                col[c] = std::fopen(p, "rb");
+                if (!col[c]) { std::cerr << p << ": cannot open trace file\n"; failed = true; return; }
+                std::fseek(col[c], sizeof h + c * h.n * sizeof(std::int64_t), SEEK_SET);
+            }
+        } else if (in != stdin) {
+            std::rewind(in);      // text: start again from the first byte
+        }
+        buf.resize(1 << 16);
+    }
+    ~TraceReader() {
+        if (in && in != stdin) std::fclose(in);
+        for (std::FILE *c : col) if (c) std::fclose(c);
+    }
+
+    // Next process: false at the end of the trace (or on error, with failed set)
+    bool next(long long &at, long long &bt, long long &pr) {
+        if (failed) return false;
+        pr = 0;
+        if (binary) {
+            if (left == 0) return false;
+            left--;
+            line++;
+            std::int64_t v[3] = {0, 0, 0};
+            for (int c = 0; c < cols; c++)
+                if (std::fread(&v[c], sizeof v[c], 1, col[c]) != 1) {
+                    std::cerr << path << ": binary trace is truncated\n";
+                    failed = true;
+                    return false;
+                }
+            if (v[0] < 0 || v[1] < 0) {
+                std::cerr << path << ": process " << line << " has a negative AT or BT\n";
+                failed = true;
+                return false;
+            }
+            at = v[0]; bt = v[1]; pr = v[2];
+            return true;
+        }
+
+        const char *b, *e;
+        while (getLine(b, e)) {
+            line++;
+            long long v[3];
+            int k = parseTraceLine(b, e, line == 1, v);
+            if (k == 0) continue;
+            if (k < 0 || (cols && k != cols)) {
+                std::cerr << path << ":" << line << ": malformed trace line\n";
+                failed = true;
+                return false;
+            }
+            if (v[0] < 0 || (k > 1 && v[1] < 0)) { // AT and BT; a priority may be negative
+                std::cerr << path << ":" << line << ": negative AT or BT\n";
+                failed = true;
+                return false;
+            }
+            cols = k;
+            if (k == 1) { at = 0; bt = v[0]; }
+            else { at = v[0]; bt = v[1]; if (k == 3) pr = v[2]; }
+            return true;
+        }
+        return false;
+    }
+
+private:
+    const char *path;             // for error messages
+    std::FILE *in = nullptr;      // text input
+    std::FILE *col[3] = {nullptr, nullptr, nullptr}; // binary input, one stream per column
+    bool binary = false;
+    int cols = 0;                 // values per record
+    std::uint64_t left = 0;       // binary records not read yet
+    std::vector<char> buf;        // text buffer: bytes [pos, len) are not parsed yet
+    size_t pos = 0, len = 0;
+    bool eof = false;
+
+    // Next text line as [b, e), without the newline; refills the buffer as needed
+    bool getLine(const char *&b, const char *&e) {
+        while (true) {
+            char *nl = (char *)std::memchr(buf.data() + pos, '\n', len - pos);
+            if (nl || (eof && pos < len)) {
+                b = buf.data() + pos;
+                e = nl ? nl : buf.data() + len;
+                pos = nl ? nl - buf.data() + 1 : len;
+                return true;
+            }
+            if (eof) return false;
+            std::memmove(buf.data(), buf.data() + pos, len - pos); // keep the partial line
+            len -= pos;
+            pos = 0;
+            if (len == buf.size()) buf.resize(buf.size() * 2);   // a very long line
+            size_t got = std::fread(buf.data() + len, 1, buf.size() - len, in);
+            len += got;
+            if (got == 0) eof = true;
+        }
+    }
+};
+
+#endif
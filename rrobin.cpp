@@ -5,76 +5,111 @@
     - Round Robin is a preemptive CPU scheduling algorithm.
     - Each process is given a fixed time slice called Time Quantum (TQ).
     - Processes are executed in a cyclic order; if a process doesn't finish within its quantum,
-      it is preempted and placed at the back of the ready list.
+      it is preempted and placed at the back of the ready queue.
     - Good for time-sharing systems; provides fairness but may increase context switches.
 
     WHAT DOES THIS PROGRAM DO?
     - Reads number of processes and the time quantum.
-    - Reads burst times for each process.
-    - Simulates Round Robin scheduling to compute Waiting Time (WT) and Turn-Around Time (TAT).
-    - Prints per-process Burst Time, Waiting Time and Turn-Around Time.
+    - Reads Arrival Time (AT) and Burst Time (BT) for each process,
+      or reads them all from a trace file (rrobin --trace FILE --tq Q, see proc_trace.h).
+    - Simulates Round Robin with a FIFO ready queue to compute Completion Time (CT),
+      Turn-Around Time (TAT) and Waiting Time (WT).
+    - Prints per-process times and average WT and TAT.
+    - --stats also prints waiting, turn-around and response time percentiles, context switches
+      and preemptions; --timeline FILE saves the Gantt chart (see sched_probe.h).
+
+    ARRIVALS AND THE READY QUEUE
+    - A process joins the back of the ready queue when it arrives.
+    - If a process arrives while another one is running, it is queued before the running
+      process is put back (the usual textbook convention).
+    - A process with BT 0 needs no CPU: it finishes the moment it arrives (CT = AT).
+
+    FAST-FORWARDING FULL ROUNDS
+    - If no process can finish and no new process can arrive during the next k rounds,
+      the queue looks exactly the same after those k rounds: every process just loses k*TQ.
+    - So we skip them in one step: time += k * (queue size) * TQ.
+    - The same holds for the part of a round before the next finish or arrival: the processes
+      in front just lose one more quantum each and move to the back of the queue.
+    - The ready queue is kept in a treap ordered by queue position, with "subtract from a whole
+      range" and "smallest remaining time in a range" done lazily. Every jump is O(log n), and
+      there are at most 2n jumps (one per finish, one per arrival), so the cost does not depend
+      on burst times or on the size of the quantum.
+    - The simulation is roundRobin() in sched_engines.h.
 */
 
 #include <iostream>     // For input/output (cin, cout)
+#include <vector>       // For vector (process table of any size)
+#include <cstdlib>      // For atoll
+#include "proc_trace.h" // For ProcessTable, loadTrace()
+#include "sched_engines.h" // For roundRobin()
 using namespace std;    // Use the standard namespace to avoid std:: prefix
 
-int main() {
-    int n, tq;                          // n = number of processes, tq = time quantum
-    cout << "Enter number of processes: "; // Prompt for number of processes
-    cin >> n;                           // Read number of processes
-
-    int pid[20], bt[20], rem[20], wt[20], tat[20]; // Arrays:
-                                                   // pid - process IDs
-                                                   // bt  - burst times
-                                                   // rem - remaining burst times
-                                                   // wt  - waiting times
-                                                   // tat - turn-around times
-
-    cout << "Enter Time Quantum: ";     // Prompt for time quantum
-    cin >> tq;                          // Read time quantum
-
-    for (int i = 0; i < n; i++) {       // Loop to get burst time for each process
-        cout << "Enter Burst Time of P" << i+1 << ": "; // Prompt for burst time of Pi
-        cin >> bt[i];                   // Read burst time into bt[i]
-        pid[i] = i + 1;                 // Assign process id (1-based)
-        rem[i] = bt[i];                 // Initialize remaining time to full burst time
-        wt[i] = 0;                      // Initialize waiting time to 0
-    }
+int main(int argc, char *argv[]) {
+    ios::sync_with_stdio(false);        // faster cin/cout for large inputs
 
-    int time = 0;                       // time keeps track of the current global time
-
-    // Round Robin logic: loop until all processes finish
-    while (true) {
-        bool done = true;               // Assume all processes are done; will set false if any rem > 0
-
-        for (int i = 0; i < n; i++) {   // Iterate over each process in cyclic order
-            if (rem[i] > 0) {           // If this process still needs CPU time
-                done = false;           // At least one process still pending -> not done
-
-                if (rem[i] > tq) {      // If remaining time is more than one quantum
-                    time += tq;         // Execute for one quantum: advance time
-                    rem[i] -= tq;       // Decrease remaining time by quantum
-                }
-                else {                  // If remaining time is <= quantum => process will finish now
-                    time += rem[i];     // Advance time by remaining amount
-                    wt[i] = time - bt[i]; // Waiting time = total time elapsed - its burst time
-                    rem[i] = 0;         // Mark process as finished (no remaining time)
-                }
-            }
+    long long tq = 0;                   // tq = time quantum
+    ProcessTable pt;                    // Process table: pt.art = arrival times, pt.bt = burst times
+    const char *trace = argValue(argc, argv, "--trace");
+    if (trace) {                        // Batch mode: every process comes from the trace file
+        const char *q = argValue(argc, argv, "--tq");
+        if (!q || atoll(q) <= 0) {
+            cerr << "usage: rrobin --trace FILE --tq QUANTUM [--stats] [--timeline FILE]\n";
+            return 1;
         }
+        tq = atoll(q);
+        if (!loadTrace(trace, pt)) return 1;
+    } else {
+        int n;                              // n = number of processes
+        cout << "Enter number of processes: "; // Prompt for number of processes
+        cin >> n;                           // Read number of processes
+        pt.art.resize(n);
+        pt.bt.resize(n);
 
-        if (done) break;                // If no process needed CPU in this pass, exit the loop
+        cout << "Enter Time Quantum: ";     // Prompt for time quantum
+        cin >> tq;                          // Read time quantum
+        if (tq <= 0) {                      // Round Robin needs a positive quantum
+            cerr << "Time Quantum must be positive\n";
+            return 1;
+        }
+
+        for (int i = 0; i < n; i++) {       // Loop to get arrival and burst time for each process
+            cout << "Enter Arrival Time & Burst Time of P" << i+1 << ": "; // Prompt for AT and BT of Pi
+            cin >> pt.art[i] >> pt.bt[i];   // Read arrival time and burst time
+        }
     }
 
-    // Calculate Turn-Around Time for each process
+    int n = pt.size();                  // n = number of processes
+    const vector<long long> &art = pt.art, &bt = pt.bt; // Short names for the AT and BT columns
+    vector<long long> ct(n), tat(n), wt(n); // ct - completion, tat - turn-around, wt - waiting times
+
+    const char *timeline = argValue(argc, argv, "--timeline"); // binary Gantt chart (sched_probe.h)
+    bool stats = argFlag(argc, argv, "--stats");              // print latency percentiles too
+    SchedProbe probe(stats || timeline ? n : 0, 1, timeline); // sees every run when enabled
+    if (!probe.ok()) return 1;
+
+    if (stats || timeline) roundRobin(art, bt, tq, ct, probe);
+    else roundRobin(art, bt, tq, ct);   // Run the simulation, fills ct[]
+
+    double total_wt = 0, total_tat = 0; // Totals for averages
     for (int i = 0; i < n; i++) {
-        tat[i] = bt[i] + wt[i];         // TAT = BT + WT
+        tat[i] = ct[i] - art[i];        // TAT = CT - AT
+        wt[i] = tat[i] - bt[i];         // WT = TAT - BT
+        total_wt += wt[i];
+        total_tat += tat[i];
     }
 
     // Display results in a table
-    cout << "\nPID\tBT\tWT\tTAT\n";      // Header: Process ID, Burst Time, Waiting Time, Turn-Around Time
+    cout << "\nPID\tAT\tBT\tCT\tTAT\tWT\n";
     for (int i = 0; i < n; i++) {
-        cout << pid[i] << "\t" << bt[i] << "\t" << wt[i] << "\t" << tat[i] << "\n"; // Row per process
+        cout << "P" << i + 1 << "\t" << art[i] << "\t" << bt[i] << "\t"
+             << ct[i] << "\t" << tat[i] << "\t" << wt[i] << "\n"; // Row per process
+    }
+
+    cout << "\nAverage Waiting Time     : " << total_wt / n << endl;
+    cout << "Average Turn-Around Time : " << total_tat / n << endl;
+    if (stats) {                                 // latency percentiles, context switches, preemptions
+        probe.finish(art, bt, ct);
+        probe.report(cout);
     }
 
     return 0;                           // Successful termination
@@ -0,0 +1,213 @@
+/*
+    TOPIC: Scheduler Benchmark - how fast do the simulators run?
+
+    WHAT DOES THIS PROGRAM DO?
+    - Times every engine in sched_engines.h (fcfs, sjf, srtf, prio, rr, and smp = SRTF on
+      --cpus CPUs with work stealing) on synthetic workloads of n = 10^3, 10^4, ... 10^7
+      processes (workload.h; every workload option of workload_gen is accepted), or on a real
+      trace with --trace FILE.
+    - Reports simulated events per second, where the events are every arrival, every
+      completion and every preemption or quantum end the engine actually simulates (quanta
+      that roundRobin() skips in one step are not counted).
+    - Small runs are repeated until --min-time seconds have passed and the best time is kept,
+      so the numbers are stable from 10^3 up.
+
+    CATCHING REGRESSIONS
+    - Save a run:        sched_bench --out base.csv
+    - Compare later:     sched_bench --baseline base.csv [--tolerance 20]
+      Every (engine, n) that got more than --tolerance percent slower (in events per second)
+      is reported, and the exit status is 2. Use the same machine and options for both.
+
+    USAGE
+        sched_bench [--min-n N] [--max-n N] [--engines fcfs,sjf,srtf,prio,rr,smp] [--tq Q]
+                    [--cpus K] [--min-time SECONDS] [--trace FILE] [workload options]
+                    [--out FILE] [--baseline FILE] [--tolerance PCT]
+    - Defaults: n from 10^3 to 10^7, all engines, tq 4, 4 CPUs, 0.2 s per measurement,
+      Poisson arrivals at 90% load with exponential bursts and 8 equally likely priorities.
+    - Output: CSV  engine,n,seconds,events,events_per_sec
+*/
+
+#include <iostream>         // For cout, cerr
+#include <fstream>          // For ifstream, ofstream
+#include <sstream>          // For stringstream (reading the baseline CSV)
+#include <vector>           // For vector
+#include <string>           // For string
+#include <map>              // For map (baseline rows by engine and n)
+#include <chrono>           // For steady_clock
+#include <cstdlib>          // For atoll, atof
+#include "proc_trace.h"     // For ProcessTable, loadTrace(), argValue()
+#include "sched_engines.h"  // For the scheduling engines
+#include "workload.h"       // For WorkloadSpec, generateWorkload(), parseWorkload()
+using namespace std;        // Avoid writing std:: repeatedly
+
+const char *ENGINES[] = {"fcfs", "sjf", "srtf", "prio", "rr", "smp"};
+
+// Probe that only counts the runs that end without the process finishing. It leaves
+// enabled off, so roundRobin() keeps fast-forwarding exactly as without a probe.
+struct EventCounter {
+    static constexpr bool enabled = false;
+    long long preempted = 0;
+    void run(int, int, long long, long long, bool finished) { preempted += !finished; }
+};
+
+struct Result {
+    string engine;
+    long long n = 0, events = 0;
+    double seconds = 0;
+    double rate() const { return seconds > 0 ? events / seconds : 0; }
+};
+
+// Run engine e once on pt; returns the number of simulated events
+long long runOnce(int e, const ProcessTable &pt, long long tq, int cpus, vector<long long> &ct)
+{
+    EventCounter ec;
+    if (e == 0) fcfs(arrivalOrder(pt.art), pt.art, pt.bt, ct, ec);
+    else if (e == 1) nonPreemptive(pt.art, pt.bt, pt.bt, ct, ec);
+    else if (e == 2) srtfEventDriven(pt.art, pt.bt, ct, ec);
+    else if (e == 3) priorityPreemptive(pt.art, pt.bt, pt.pr, 0, ct, ec);
+    else if (e == 4) roundRobin(pt.art, pt.bt, tq, ct, ec);
+    else {
+        SmpConfig cfg;
+        cfg.cpus = cpus;
+        cfg.policy = SMP_SRTF;
+        cfg.balance = BALANCE_STEAL;
+        SmpStats st;
+        smpSchedule(pt.art, pt.bt, pt.pr, cfg, ct, st, ec);
+    }
+    return 2LL * pt.size() + ec.preempted;  // arrivals + completions + preemptions
+}
+
+// Best time of repeated runs, repeated until minTime seconds have passed
+Result measure(int e, const ProcessTable &pt, long long tq, int cpus, double minTime)
+{
+    Result r;
+    r.engine = ENGINES[e];
+    r.n = pt.size();
+    vector<long long> ct(pt.size());
+    double total = 0;
+    do {
+        auto start = chrono::steady_clock::now();
+        r.events = runOnce(e, pt, tq, cpus, ct);
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (total == 0 || secs < r.seconds) r.seconds = secs;
+        total += secs;
+    } while (total < minTime);
+    return r;
+}
+
+// Compare with a saved run; returns the number of regressions
+int compareBaseline(const char *path, const vector<Result> &results, double tolerance)
+{
+    ifstream in(path);
+    if (!in) { cerr << path << ": cannot open baseline\n"; return -1; }
+    map<pair<string, long long>, double> base; // (engine, n) -> events per second
+    string line;
+    while (getline(in, line)) {
+        stringstream ss(line);
+        string engine, n, secs, events, rate;
+        if (getline(ss, engine, ',') && getline(ss, n, ',') && getline(ss, secs, ',') &&
+            getline(ss, events, ',') && getline(ss, rate, ',') && engine != "engine")
+            base[make_pair(engine, atoll(n.c_str()))] = atof(rate.c_str());
+    }
+
+    int regressions = 0;
+    for (const Result &r : results) {
+        auto it = base.find(make_pair(r.engine, r.n));
+        if (it == base.end() || it->second <= 0) continue;
+        double change = 100 * (r.rate() - it->second) / it->second;
+        if (change < -tolerance) {
+            cerr << "REGRESSION " << r.engine << " n=" << r.n << ": " << (long long)r.rate()
+                 << " events/s vs " << (long long)it->second << " (" << change << "%)\n";
+            regressions++;
+        }
+    }
+    return regressions;
+}
+
+int main(int argc, char *argv[])
+{
+    ios::sync_with_stdio(false);            // faster cout
+
+    const char *usage = "usage: sched_bench [--min-n N] [--max-n N] [--engines fcfs,sjf,srtf,prio,rr,smp]\n"
+                        "                   [--tq Q] [--cpus K] [--min-time SECONDS] [--trace FILE]\n"
+                        "                   [workload options, see workload_gen] [--out FILE]\n"
+                        "                   [--baseline FILE] [--tolerance PCT]\n";
+
+    // Options
+    long long minN = 1000, maxN = 10000000, tq = 4;
+    int cpus = 4;
+    double minTime = 0.2, tolerance = 20;
+    if (const char *s = argValue(argc, argv, "--min-n")) minN = atoll(s);
+    if (const char *s = argValue(argc, argv, "--max-n")) maxN = atoll(s);
+    if (const char *s = argValue(argc, argv, "--tq")) tq = atoll(s);
+    if (const char *s = argValue(argc, argv, "--cpus")) cpus = atoi(s);
+    if (const char *s = argValue(argc, argv, "--min-time")) minTime = atof(s);
+    if (const char *s = argValue(argc, argv, "--tolerance")) tolerance = atof(s);
+
+    vector<bool> use(6, true);              // engines to run
+    if (const char *s = argValue(argc, argv, "--engines")) {
+        use.assign(6, false);
+        string list = s;
+        for (size_t a = 0; a <= list.size(); ) {
+            size_t b = list.find(',', a);
+            if (b == string::npos) b = list.size();
+            string name = list.substr(a, b - a);
+            int e = 0;
+            while (e < 6 && name != ENGINES[e]) e++;
+            if (e == 6) { cerr << "unknown engine: " << name << "\n" << usage; return 1; }
+            use[e] = true;
+            a = b + 1;
+        }
+    }
+
+    WorkloadSpec spec;
+    spec.prio.assign(8, 1);                 // prio needs priorities: 1..8, equally likely
+    if (minN <= 0 || maxN < minN || tq <= 0 || cpus <= 0 || minTime < 0 || tolerance < 0 ||
+        !parseWorkload(argc, argv, spec)) {
+        cerr << usage;
+        return 1;
+    }
+
+    // Workloads: the trace, or one synthetic workload per power of ten
+    vector<ProcessTable> tables;
+    if (const char *trace = argValue(argc, argv, "--trace")) {
+        tables.resize(1);
+        if (!loadTrace(trace, tables[0])) return 1;
+        if (!tables[0].hasPriority()) tables[0].pr.assign(tables[0].size(), 0);
+    }
+
+    vector<Result> results;
+    for (long long n = minN; tables.size() == 1 || n <= maxN; n *= 10) {
+        ProcessTable generated;
+        if (tables.empty()) generateWorkload(spec, n, generated);
+        const ProcessTable &pt = tables.empty() ? generated : tables[0];
+        for (int e = 0; e < 6; e++) {
+            if (!use[e]) continue;
+            results.push_back(measure(e, pt, tq, cpus, minTime));
+            const Result &r = results.back();
+            cerr << r.engine << "\tn=" << r.n << "\t" << r.seconds << " s\t"
+                 << (long long)r.rate() << " events/s\n";
+        }
+        if (!tables.empty()) break;         // a trace is measured once
+    }
+
+    // Results
+    ofstream file;
+    if (const char *path = argValue(argc, argv, "--out")) {
+        file.open(path);
+        if (!file) { cerr << path << ": cannot create output file\n"; return 1; }
+    }
+    ostream &out = file.is_open() ? file : cout;
+    out.precision(10);
+    out << "engine,n,seconds,events,events_per_sec\n";
+    for (const Result &r : results)
+        out << r.engine << "," << r.n << "," << r.seconds << "," << r.events << "," << r.rate() << "\n";
+
+    if (const char *base = argValue(argc, argv, "--baseline")) {
+        int regressions = compareBaseline(base, results, tolerance);
+        if (regressions < 0) return 1;
+        if (regressions > 0) return 2;
+        cerr << "no regressions beyond " << tolerance << "%\n";
+    }
+    return 0;                               // successful termination
+}
@@ -0,0 +1,671 @@
+/*
+    TOPIC: Shared CPU Scheduling Engines
+
+    WHAT IS THIS FILE?
+    - Scheduling algorithms that more than one program in this folder uses.
+    - Each engine takes the process table as plain arrays (arrival time, burst time, ...)
+      and fills in the Completion Time (CT) of every process.
+    - The programs (sjf.cpp, priority.cpp, ...) read input, call an engine and print the table;
+      sched_sweep.cpp calls many engines at once on the same process table.
+    - Engines only read their inputs, so several can run on the same table in parallel threads.
+
+    ENGINES
+    - fcfs(): run processes in arrival order (arrivalOrder() sorts them in O(n)).
+    - nonPreemptive(): one engine for every non-preemptive "pick the best ready job" policy.
+        SJF      -> key = burst time
+        Priority -> key = priority (lower value = higher priority)
+    - srtfEventDriven(): Shortest Remaining Time First.
+    - priorityPreemptive(): preemptive priority, with optional aging.
+    - roundRobin(): Round Robin with arrival times.
+    - smpSchedule(): k CPUs, each with its own run queue, under FCFS, SJF, SRTF, preemptive
+      priority or RR, with optional load balancing between the queues (see below).
+
+    INSTRUMENTATION
+    - Every engine takes an optional last argument, a probe (see sched_probe.h), and calls
+      probe.run(cpu, process, start, end, finished) for each stretch a process runs.
+    - Without one the default NullProbe is used and the calls compile away.
+    - With a probe, roundRobin() simulates every quantum (its fast-forwarding would skip runs).
+*/
+
+#ifndef SCHED_ENGINES_H
+#define SCHED_ENGINES_H
+
+#include <vector>       // std::vector
+#include <queue>        // std::priority_queue (min-heap of ready processes)
+#include <algorithm>    // std::stable_sort, std::min, std::max, std::fill
+#include <numeric>      // std::iota
+#include <functional>   // std::greater
+#include <utility>      // std::pair
+#include <set>          // std::set (per-CPU run queues)
+#include <climits>      // LLONG_MAX
+#include <random>       // std::mt19937 (treap priorities in roundRobin())
+#include "sched_probe.h" // NullProbe (the default probe)
+
+// Process indices ordered by arrival time (stable: equal arrivals keep their input order)
+inline std::vector<int> arrivalOrder(const std::vector<long long> &art)
+{
+    int n = art.size();
+    std::vector<int> order(n);             // order[k] = index of the k-th process to arrive
+    if (n == 0) return order;
+
+    long long lo = *std::min_element(art.begin(), art.end());
+    unsigned long long range = (unsigned long long)*std::max_element(art.begin(), art.end()) - lo;
+
+    if (range < 4ull * n + 65536) {        // Small range: counting sort, one bucket per time value
+        std::vector<int> start(range + 2, 0);   // start[v+1] counts arrivals at lo+v, then becomes a prefix sum
+        for (int i = 0; i < n; i++) start[art[i] - lo + 1]++;
+        for (size_t v = 1; v < start.size(); v++) start[v] += start[v - 1];
+        for (int i = 0; i < n; i++) order[start[art[i] - lo]++] = i;
+        return order;
+    }
+
+    // Large range: LSD radix sort on (AT - lo), 16 bits per pass, skipping the all-zero top digits
+    std::vector<int> tmp(n);
+    std::vector<int> start(65537);
+    for (int i = 0; i < n; i++) order[i] = i;
+    for (int shift = 0; shift < 64 && (range >> shift) != 0; shift += 16) {
+        std::fill(start.begin(), start.end(), 0);
+        for (int i : order) start[((art[i] - lo) >> shift & 0xFFFF) + 1]++;
+        for (int d = 1; d <= 65536; d++) start[d] += start[d - 1];
+        for (int i : order) tmp[start[(art[i] - lo) >> shift & 0xFFFF]++] = i;
+        order.swap(tmp);
+    }
+    return order;
+}
+
+// FCFS: run each process to completion in the given arrival order (from arrivalOrder()). Fills ct[].
+template <class Probe = NullProbe>
+inline void fcfs(const std::vector<int> &order, const std::vector<long long> &art,
+                 const std::vector<long long> &bt, std::vector<long long> &ct, Probe &&probe = Probe())
+{
+    long long time = 0;                    // current time on the CPU timeline
+    for (int i : order) {
+        if (time < art[i]) time = art[i];  // CPU idle until this process arrives
+        probe.run(0, i, time, time + bt[i], true);
+        time += bt[i];                     // run it to completion
+        ct[i] = time;
+    }
+}
+
+// Non-preemptive scheduling: whenever the CPU is free, run the arrived process with the
+// smallest key to completion (ties go to the lower index). Fills ct[].
+//
+// - Processes are sorted by arrival once; arrived ones are pushed into a min-heap on key.
+// - When nothing is ready the clock jumps straight to the next arrival (no idle ticking).
+// - Total cost O(n log n).
+template <class Probe = NullProbe>
+inline void nonPreemptive(const std::vector<long long> &art, const std::vector<long long> &bt,
+                          const std::vector<long long> &key, std::vector<long long> &ct,
+                          Probe &&probe = Probe())
+{
+    int n = art.size();                    // number of processes
+
+    std::vector<int> order(n);             // process indices sorted by arrival time
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return art[a] < art[b]; });
+
+    typedef std::pair<long long, int> Entry;                 // (key, process index)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> ready; // min-heap
+
+    long long time = 0;                    // current time
+    int next = 0;                          // position in order[] of the next process to arrive
+
+    for (int done = 0; done < n; done++) { // one iteration per completed process
+        if (ready.empty() && art[order[next]] > time)
+            time = art[order[next]];       // CPU idle: jump to the next arrival
+
+        while (next < n && art[order[next]] <= time) {
+            int i = order[next++];         // admit every process that has arrived by now
+            ready.push(Entry(key[i], i));
+        }
+
+        int idx = ready.top().second;      // best ready process
+        ready.pop();
+        probe.run(0, idx, time, time + bt[idx], true);
+        time += bt[idx];                   // run it to completion
+        ct[idx] = time;                    // completion time for selected process
+    }
+}
+
+// Event-driven SRTF: fills ct[] given arrival times art[] and burst times bt[]
+template <class Probe = NullProbe>
+inline void srtfEventDriven(const std::vector<long long> &art, const std::vector<long long> &bt,
+                            std::vector<long long> &ct, Probe &&probe = Probe())
+{
+    int n = art.size();                    // number of processes
+    std::vector<long long> rt(bt);         // rt: remaining time, initially equals burst time
+
+    std::vector<int> order(n);             // process indices sorted by arrival time
+    std::iota(order.begin(), order.end(), 0);   // 0, 1, ..., n-1
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return art[a] < art[b]; });
+
+    // min-heap of (remaining time, index): ties go to the lower index, same as the unit-time loop
+    typedef std::pair<long long, int> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> ready;
+
+    long long time = 0;                    // current time in simulation
+    int next = 0;                          // position in order[] of the next process to arrive
+    int completed = 0;                     // number of completed processes
+
+    // Main loop: one iteration per event (arrival batch or completion)
+    while (completed < n) {
+
+        // If nothing is ready, the CPU is idle: jump straight to the next arrival
+        if (ready.empty() && art[order[next]] > time)
+            time = art[order[next]];
+
+        // Admit every process that has arrived by now
+        while (next < n && art[order[next]] <= time) {
+            int i = order[next++];         // index of arriving process
+            ready.push({rt[i], i});        // add it to the ready heap
+        }
+
+        int idx = ready.top().second;      // process with smallest remaining time
+        ready.pop();                       // take it out of the heap while it runs
+
+        // Run it until it finishes or until the next arrival, whichever comes first
+        long long nextArrival = (next < n) ? art[order[next]] : LLONG_MAX;
+        long long slice = std::min(rt[idx], nextArrival - time);
+        rt[idx] -= slice;                  // consume CPU time
+        probe.run(0, idx, time, time + slice, rt[idx] == 0);
+        time += slice;                     // advance clock to the next event
+
+        if (rt[idx] == 0) {                // process finished at this event
+            ct[idx] = time;                // completion time is current time
+            completed++;                   // increment number of completed processes
+        } else {
+            ready.push({rt[idx], idx});    // preempted by an arrival: back into the heap
+        }
+    }
+}
+
+// Min-heap of process indices ordered by (key[i], i); keys live outside the heap
+class IndexHeap {
+public:
+    std::vector<int> heap;         // heap[0] is the process with the smallest key
+    const std::vector<long long> &key;  // key of each process (owned by the caller)
+
+    IndexHeap(const std::vector<long long> &k) : key(k) {}
+
+    bool less(int a, int b) {      // heap order: smaller key first, lower index on ties
+        return key[a] < key[b] || (key[a] == key[b] && a < b);
+    }
+
+    bool empty() { return heap.empty(); }
+    int top() { return heap[0]; }
+
+    void push(int i) {             // insert process i and sift it up
+        heap.push_back(i);
+        int c = heap.size() - 1;
+        while (c > 0 && less(heap[c], heap[(c - 1) / 2])) {
+            std::swap(heap[c], heap[(c - 1) / 2]);
+            c = (c - 1) / 2;
+        }
+    }
+
+    void pop() {                   // remove the top process and sift the last one down
+        heap[0] = heap.back();
+        heap.pop_back();
+        int p = 0, n = heap.size();
+        while (true) {
+            int best = p, l = 2 * p + 1, r = 2 * p + 2;
+            if (l < n && less(heap[l], heap[best])) best = l;
+            if (r < n && less(heap[r], heap[best])) best = r;
+            if (best == p) break;
+            std::swap(heap[p], heap[best]);
+            p = best;
+        }
+    }
+};
+
+// Integer division rounded towards +infinity (works for negative numerators too)
+inline long long ceilDiv(long long a, long long b) {
+    return a / b + ((a % b != 0) && ((a > 0) == (b > 0)));
+}
+
+// Event-driven preemptive priority: fills ct[]; aging = 0 disables aging
+template <class Probe = NullProbe>
+inline void priorityPreemptive(const std::vector<long long> &art, const std::vector<long long> &bt,
+                               const std::vector<long long> &pr, long long aging, std::vector<long long> &ct,
+                               Probe &&probe = Probe())
+{
+    int n = art.size();                       // number of processes
+    std::vector<long long> rem(bt);           // rem: remaining burst time for each process
+    std::vector<long long> key(n);            // heap key of each waiting process
+    IndexHeap ready(key);                     // waiting (ready but not running) processes
+
+    std::vector<int> order(n);                // process indices sorted by arrival time
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return art[a] < art[b]; });
+
+    // Effective priority of waiting process i at time t
+    auto effective = [&](int i, long long t) {
+        return aging ? ceilDiv(key[i] - t, aging) : pr[i];
+    };
+    // Put process i in the ready heap; with aging its wait clock starts at time t
+    auto makeReady = [&](int i, long long t) {
+        key[i] = aging ? pr[i] * aging + t : pr[i];
+        ready.push(i);
+    };
+
+    long long time = 0;                       // current simulation time
+    int next = 0, completed = 0;              // next arrival in order[], number of finished processes
+    int cur = -1;                             // process currently on the CPU (-1 = idle)
+    long long curPr = 0;                      // priority the running process holds (its aged PR when dispatched)
+
+    // Main simulation loop: one iteration per event
+    while (completed < n) {
+
+        if (cur == -1 && ready.empty() && art[order[next]] > time)
+            time = art[order[next]];          // CPU idle: jump to the next arrival
+
+        while (next < n && art[order[next]] <= time)
+            makeReady(order[next++], time);   // admit all processes that have arrived by now
+
+        // Dispatch: the best waiting process takes the CPU if it has a strictly better priority.
+        // Without aging, equal priority and lower index also wins, as in the unit-time loop.
+        if (!ready.empty()) {
+            int j = ready.top();
+            long long e = effective(j, time);
+            if (cur == -1 || e < curPr || (!aging && e == curPr && j < cur)) {
+                ready.pop();
+                if (cur != -1) makeReady(cur, time); // preempted process goes back to waiting
+                cur = j;
+                curPr = e;                    // it keeps its aged priority while it runs
+            }
+        }
+
+        // Next event: completion, next arrival, or the aged priority of the best waiter catching up
+        long long until = time + rem[cur];
+        if (next < n) until = std::min(until, art[order[next]]);
+        if (aging && !ready.empty()) {
+            long long target = curPr - 1;                   // effective PR the best waiter needs
+            until = std::min(until, key[ready.top()] - target * aging); // first time ceil((key-t)/A) <= target
+        }
+
+        rem[cur] -= until - time;             // run the current process up to the event
+        probe.run(0, cur, time, until, rem[cur] == 0);
+        time = until;
+
+        if (rem[cur] == 0) {                  // process completes
+            ct[cur] = time;                   // completion time is current time
+            completed++;                      // one more process finished
+            cur = -1;                         // CPU is free for the next dispatch
+        }
+    }
+}
+
+// The ready queue as an implicit treap: nodes are kept in queue order (front first) and every
+// node is a process index. rem[] is each process's remaining time, lo[] the smallest rem[] in
+// its subtree, and sub[] a pending "subtract this from the whole subtree" (lazy) value.
+class ReadyQueue {
+public:
+    std::vector<int> L, R, sz;      // children and subtree size of each node
+    std::vector<unsigned> pri;      // random heap priority keeps the tree balanced
+    std::vector<long long> rem, lo, sub; // remaining time, subtree minimum, pending subtraction
+    int root = -1;                  // -1 = empty queue
+
+    ReadyQueue(int n) : L(n), R(n), sz(n), pri(n), rem(n), lo(n), sub(n) {
+        std::mt19937 rng(12345);    // fixed seed: same tree shape on every run
+        for (auto &p : pri) p = rng();
+    }
+
+    int size(int t) { return t == -1 ? 0 : sz[t]; }
+    int size() { return size(root); }
+    long long minRem() { return lo[root]; }
+
+    void subtract(int t, long long d) {     // lazily take d off every process in subtree t
+        if (t == -1) return;
+        rem[t] -= d; lo[t] -= d; sub[t] += d;
+    }
+    void push(int t) {                      // hand the pending subtraction down to the children
+        if (sub[t]) { subtract(L[t], sub[t]); subtract(R[t], sub[t]); sub[t] = 0; }
+    }
+    void pull(int t) {                      // recompute size and minimum from the children
+        sz[t] = 1 + size(L[t]) + size(R[t]);
+        lo[t] = rem[t];
+        if (L[t] != -1) lo[t] = std::min(lo[t], lo[L[t]]);
+        if (R[t] != -1) lo[t] = std::min(lo[t], lo[R[t]]);
+    }
+    int merge(int a, int b) {               // queue a followed by queue b
+        if (a == -1) return b;
+        if (b == -1) return a;
+        if (pri[a] > pri[b]) { push(a); R[a] = merge(R[a], b); pull(a); return a; }
+        push(b); L[b] = merge(a, L[b]); pull(b); return b;
+    }
+    void split(int t, int k, int &a, int &b) { // first k processes of t into a, the rest into b
+        if (t == -1) { a = b = -1; return; }
+        push(t);
+        if (size(L[t]) < k) { split(R[t], k - size(L[t]) - 1, R[t], b); a = t; }
+        else                { split(L[t], k, a, L[t]); b = t; }
+        pull(t);
+    }
+
+    void pushBack(int i, long long r) {     // process i joins the back with r time units left
+        L[i] = R[i] = -1; sz[i] = 1; rem[i] = lo[i] = r; sub[i] = 0;
+        root = merge(root, i);
+    }
+    int popFront() {                        // take the process at the front out of the queue
+        int f, rest;
+        split(root, 1, f, rest);
+        root = rest;
+        return f;
+    }
+    void rotate(int k, long long d) {       // first k processes run d more and move to the back
+        int a, b;
+        split(root, k, a, b);
+        subtract(a, d);
+        root = merge(b, a);
+    }
+    int firstAtMost(long long x, int &pos) { // earliest process with rem <= x (one must exist)
+        int t = root;
+        pos = 0;
+        while (true) {
+            push(t);
+            if (L[t] != -1 && lo[L[t]] <= x) { t = L[t]; continue; }
+            if (rem[t] <= x) { pos += size(L[t]); return t; }
+            pos += size(L[t]) + 1;
+            t = R[t];
+        }
+    }
+    void removeAt(int p, long long before, long long after) { // drop position p; processes in
+        int a, rest, mid, b;                                   // front of it ran 'before' more,
+        split(root, p, a, rest);                               // the ones behind ran 'after' more
+        split(rest, 1, mid, b);
+        subtract(a, before);
+        subtract(b, after);
+        root = merge(b, a);                 // the queue carries on from just behind p
+    }
+};
+
+// Round Robin with arrival times: fills ct[] given arrival times, burst times and the quantum
+template <class Probe = NullProbe>
+inline void roundRobin(const std::vector<long long> &art, const std::vector<long long> &bt, long long tq,
+                       std::vector<long long> &ct, Probe &&probe = Probe())
+{
+    int n = art.size();                     // number of processes
+
+    std::vector<int> order(n);              // process indices sorted by arrival time
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return art[a] < art[b]; });
+
+    ReadyQueue q(n);                        // FIFO ready queue
+    long long time = 0;                     // time keeps track of the current global time
+    int next = 0;                           // position in order[] of the next process to arrive
+    int done = 0;                           // number of finished processes
+    auto admit = [&]() {                    // queue every process that has arrived by now
+        while (next < n && art[order[next]] <= time) {
+            int i = order[next++];
+            if (bt[i] <= 0) {               // nothing to run: finished on arrival
+                ct[i] = art[i];
+                done++;
+                continue;
+            }
+            q.pushBack(i, bt[i]);
+        }
+    };
+
+    // Round Robin logic: one iteration per finish or per arrival
+    while (done < n) {
+        if (q.size() == 0)                  // CPU idle: jump to the next arrival
+            time = std::max(time, art[order[next]]);
+        admit();
+        if (q.size() == 0) continue;        // only zero-burst processes arrived
+
+        // A probe sees every quantum, so fast-forwarding is only done without one
+        if (!probe.enabled) {
+            // The first process to finish needs the fewest turns c; on ties, it is the one nearest
+            // the front. Everything before its last turn is (c-1) full rounds plus p quanta.
+            long long m = q.size();
+            long long c = (q.minRem() + tq - 1) / tq;        // turns the first finisher needs
+            int p;
+            int i = q.firstAtMost(c * tq, p);                // the first finisher, at position p
+            long long quanta = (c - 1) * m + p;              // full quanta before its last turn
+            long long finish = time + quanta * tq + (q.rem[i] - (c - 1) * tq);
+
+            if (next == n || finish <= art[order[next]]) {
+                // Nobody arrives before it finishes: jump straight to its completion
+                q.removeAt(p, c * tq, (c - 1) * tq);
+                time = finish;
+                ct[i] = time;               // finished: record completion time
+                done++;
+                admit();                    // arrivals at exactly this moment join the back
+                continue;
+            }
+
+            // Someone arrives first: skip every full quantum that ends before the arrival
+            long long skip = (art[order[next]] - 1 - time) / tq;
+            if (skip > 0) {
+                q.subtract(q.root, (skip / m) * tq); // skip/m full rounds: everyone loses that much
+                q.rotate(skip % m, tq);              // the rest of a round: front ones lose one more
+                time += skip * tq;
+            }
+        }
+
+        // Run one quantum (the one during which the arrival happens) one step at a time
+        int f = q.popFront();
+        long long rem = q.rem[f];           // its remaining time
+        long long slice = std::min(rem, tq);     // run for a quantum or until it finishes
+        probe.run(0, f, time, time + slice, rem == slice);
+        time += slice;
+        rem -= slice;
+
+        admit();                            // arrivals during this quantum queue up first
+        if (rem == 0) {
+            ct[f] = time;                   // finished: record completion time
+            done++;
+        } else {
+            q.pushBack(f, rem);             // preempted: back of the queue
+        }
+    }
+}
+
+/*
+    SMP (MULTI-CPU) SCHEDULING
+
+    - Each CPU has its own run queue, ordered by the policy's key:
+        FCFS -> arrival time, SJF -> burst time, SRTF -> remaining time,
+        PRIO -> priority, RR -> queue order (quantum tq)
+      SRTF and PRIO preempt when a better process arrives or migrates in, unless cfg.preempt
+      is false. Under RR a process with BT 0 finishes the moment it arrives, as in roundRobin().
+      Ties go to the lower process index, so with 1 CPU the results match the single-CPU programs.
+    - New processes are placed on the CPUs in turn (P1 on CPU0, P2 on CPU1, ...).
+    - Load balancing moves waiting processes between queues (each move is a migration):
+        none  -> processes stay where they were placed
+        push  -> every 'interval' time units, move processes from the busiest CPU to the
+                 least loaded one until their loads differ by at most 1
+        steal -> a CPU with nothing to run takes a waiting process from the busiest queue
+    - Discrete-event simulation: only arrivals, completions, quantum ends and balancing
+      ticks are simulated. Without RR the cost is O(n (log n + k)) whatever the burst times;
+      RR adds O(log n) per quantum (no round fast-forwarding as in rrobin.cpp).
+*/
+
+enum SmpPolicy { SMP_FCFS, SMP_SJF, SMP_SRTF, SMP_PRIO, SMP_RR };
+enum SmpBalance { BALANCE_NONE, BALANCE_PUSH, BALANCE_STEAL };
+
+struct SmpConfig {
+    int cpus = 1;                          // number of CPUs (k)
+    SmpPolicy policy = SMP_FCFS;           // per-CPU scheduling policy
+    SmpBalance balance = BALANCE_NONE;     // load-balancing policy
+    long long tq = 1;                      // RR time quantum
+    long long interval = 1;                // push migration: time between balancing passes
+    bool preempt = true;                   // SRTF, PRIO: a better waiting process takes the CPU
+                                           // (false: every process runs to completion)
+};
+
+struct SmpStats {
+    std::vector<long long> busy;           // per CPU: time spent running processes
+    std::vector<long long> ran;            // per CPU: processes that completed there
+    std::vector<long long> migIn, migOut;  // per CPU: migrations into / out of its queue
+    std::vector<int> cpuOf;                // per process: CPU it completed on
+    long long migrations = 0;              // total migrations
+};
+
+// Run-queue key of a process under policy: the smallest key runs first (ties: lower index).
+// RR takes the next value of seq, so the queue is in order of joining.
+inline long long smpKey(SmpPolicy policy, long long arrival, long long burst, long long remaining,
+                        long long priority, long long &seq)
+{
+    switch (policy) {
+    case SMP_FCFS: return arrival;
+    case SMP_SJF: return burst;
+    case SMP_SRTF: return remaining;
+    case SMP_PRIO: return priority;
+    default: return seq++;
+    }
+}
+
+// Simulate cfg.cpus CPUs: fills ct[] and st. pr[] is only used by SMP_PRIO.
+template <class Probe = NullProbe>
+inline void smpSchedule(const std::vector<long long> &art, const std::vector<long long> &bt,
+                        const std::vector<long long> &pr, const SmpConfig &cfg,
+                        std::vector<long long> &ct, SmpStats &st, Probe &&probe = Probe())
+{
+    int n = art.size(), k = cfg.cpus;
+    SmpPolicy policy = cfg.policy;
+    bool preemptive = cfg.preempt && (policy == SMP_SRTF || policy == SMP_PRIO);
+
+    st.busy.assign(k, 0); st.ran.assign(k, 0); st.migIn.assign(k, 0); st.migOut.assign(k, 0);
+    st.cpuOf.assign(n, -1); st.migrations = 0;
+
+    std::vector<int> order(n);             // process indices sorted by arrival time
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return art[a] < art[b]; });
+
+    typedef std::pair<long long, int> Entry;             // (key, process index)
+    std::vector<std::set<Entry>> q(k);     // per-CPU run queue of waiting processes
+    std::vector<int> cur(k, -1);           // process running on each CPU (-1 = idle)
+    std::vector<long long> runStart(k);    // when the running process was (re)started
+    std::vector<long long> due(k, -1);     // when the running process finishes or its quantum ends
+    std::vector<long long> rem(bt), key(n);
+    long long seq = 0;                     // RR: order in which processes joined a queue
+    long long waiting = 0;                 // processes sitting in some run queue
+
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> events; // (due time, CPU)
+
+    auto load = [&](int c) { return (long long)q[c].size() + (cur[c] != -1); };
+    auto enqueue = [&](int c, int i) {     // process i waits on CPU c
+        key[i] = smpKey(policy, art[i], bt[i], rem[i], pr[i], seq);
+        q[c].insert(Entry(key[i], i));
+        waiting++;
+    };
+    auto start = [&](int c, long long t) { // idle CPU c runs the best process in its queue
+        if (q[c].empty()) return;
+        int i = q[c].begin()->second;
+        q[c].erase(q[c].begin());
+        waiting--;
+        cur[c] = i;
+        runStart[c] = t;
+        due[c] = t + (policy == SMP_RR ? std::min(rem[i], cfg.tq) : rem[i]);
+        events.push(Entry(due[c], c));
+    };
+    auto stop = [&](int c, long long t) {  // take the running process off CPU c at time t
+        int i = cur[c];
+        rem[i] -= t - runStart[c];
+        st.busy[c] += t - runStart[c];
+        probe.run(c, i, runStart[c], t, rem[i] == 0);
+        cur[c] = -1;
+        due[c] = -1;
+        return i;
+    };
+    auto migrate = [&](int from, int to) { // move the last waiting process of 'from' to 'to'
+        auto it = std::prev(q[from].end());
+        int i = it->second;
+        q[from].erase(it);
+        waiting--;
+        enqueue(to, i);                    // RR: it joins the back of its new queue
+        st.migrations++; st.migOut[from]++; st.migIn[to]++;
+    };
+    // Busy CPU c: the best waiting process takes the CPU if it beats the running one
+    // (unless that one ends now). Called when processes arrive or migrate to c.
+    auto preemptIfBeaten = [&](int c, long long t) {
+        if (!preemptive || due[c] <= t || q[c].empty()) return;
+        int j = cur[c];
+        long long kj = policy == SMP_SRTF ? rem[j] - (t - runStart[c]) : pr[j];
+        if (*q[c].begin() < Entry(kj, j)) {
+            enqueue(c, stop(c, t));
+            start(c, t);
+        }
+    };
+    auto busiest = [&]() {                 // CPU with the longest queue of waiting processes
+        int b = -1;
+        for (int c = 0; c < k; c++)
+            if (!q[c].empty() && (b == -1 || q[c].size() > q[b].size())) b = c;
+        return b;
+    };
+
+    long long time = 0, nextTick = LLONG_MAX; // nextTick: next push-migration pass (if needed)
+    int next = 0, placed = 0;
+    std::vector<int> touched;              // CPUs that got new processes at this time
+    for (int done = 0; done < n; ) {
+        while (!events.empty() && due[events.top().second] != events.top().first)
+            events.pop();                  // drop events of processes that were preempted
+        long long tA = next < n ? art[order[next]] : LLONG_MAX;
+        long long tC = events.empty() ? LLONG_MAX : events.top().first;
+        long long tB = waiting > 0 ? nextTick : LLONG_MAX;
+        time = std::min(tA, std::min(tC, tB));
+
+        if (tA == time) {                  // 1) arrivals (all arrivals come before CPU events)
+            touched.clear();
+            while (next < n && art[order[next]] == time) {
+                int i = order[next++];
+                int c = placed++ % k;      // place new processes on the CPUs in turn
+                if (policy == SMP_RR && bt[i] <= 0) { // as in roundRobin(): finished on arrival
+                    ct[i] = time;
+                    st.cpuOf[i] = c;
+                    st.ran[c]++;
+                    done++;
+                    continue;
+                }
+                enqueue(c, i);
+                touched.push_back(c);
+            }
+            for (int c : touched) {
+                if (cur[c] == -1) start(c, time);
+                else preemptIfBeaten(c, time);
+            }
+            if (cfg.balance == BALANCE_STEAL)
+                for (int d = 0; d < k; d++)  // idle CPUs steal the newcomers that have to wait
+                    if (cur[d] == -1) {
+                        int b = busiest();
+                        if (b == -1) break;
+                        migrate(b, d);
+                        start(d, time);
+                    }
+        } else if (tC == time) {           // 2) a completion or the end of an RR quantum
+            int c = events.top().second;
+            events.pop();
+            int i = stop(c, time);
+            if (rem[i] == 0) {
+                ct[i] = time;
+                st.cpuOf[i] = c;
+                st.ran[c]++;
+                done++;
+            } else {
+                enqueue(c, i);             // quantum expired: back of the queue
+            }
+            start(c, time);
+            if (cur[c] == -1 && cfg.balance == BALANCE_STEAL) {
+                int b = busiest();         // nothing left here: steal from the busiest queue
+                if (b != -1) { migrate(b, c); start(c, time); }
+            }
+        } else {                           // 3) push migration pass
+            while (true) {
+                int hi = busiest(), lo = 0;
+                if (hi == -1) break;
+                for (int c = 1; c < k; c++) if (load(c) < load(lo)) lo = c;
+                if (load(hi) - load(lo) <= 1) break;
+                migrate(hi, lo);
+                if (cur[lo] == -1) start(lo, time);
+                else preemptIfBeaten(lo, time);
+            }
+            nextTick = LLONG_MAX;          // balanced until the next arrival or completion
+            continue;
+        }
+
+        if (cfg.balance == BALANCE_PUSH && (nextTick == LLONG_MAX || nextTick < time)) // loads changed:
+            nextTick = (time / cfg.interval + (time % cfg.interval != 0)) * cfg.interval; // balance at the next tick
+    }
+}
+
+#endif
@@ -0,0 +1,383 @@
+/*
+    TOPIC: CPU Scheduling and Paging Together - page faults block processes
+
+    WHY COMBINE THEM?
+    - The scheduling programs assume a process computes for its whole burst, and
+      page_replace.cpp counts faults without asking what the CPU does meanwhile. In a real
+      system a page fault blocks the process until the disk has read the page, and the
+      scheduler runs someone else. With too many processes for the memory, every process
+      keeps faulting, they all wait for the disk and the CPU sits idle: thrashing.
+
+    WHAT DOES THIS PROGRAM DO?
+    - Reads n processes with Arrival Time (AT), Burst Time (BT) and Priority (PR), or reads
+      them all from a trace file (--trace FILE, see proc_trace.h).
+    - Every time unit a process runs it makes one page reference. Its references come from
+      --page-traces F1,F2,... (process i replays file i mod k, from the start again when it
+      runs out; format options as in page_replace, see page_trace.h) or, by default, from a
+      locality model: --wss W pages (default 16) used at random, moving to W new pages every
+      --phase L references (default 10000). --seed S varies the streams.
+    - All processes share --frames F physical frames under one replacement policy (--algo
+      fifo, lru (default), clock, lfu, 2q, arc or lirs; see page_policies.h), each in its own
+      address space.
+    - A fault blocks the process for --disk D time units (default 100) on one of --disks K
+      disks (default 1; busy disks queue the requests) while the scheduler (--policy rr, srtf
+      or prio) runs another process. The page is loaded when the fault happens, and the
+      reference completes when the process runs again.
+    - Prints per-process times and faults, CPU utilization, throughput and the fault rate,
+      then the CPU utilization at each degree of multiprogramming (processes arrived and not
+      finished): as the degree grows, utilization rises and then, when the memory can no
+      longer hold their working sets, collapses.
+    - --curve FILE writes the same over time as CSV, one row per --every T time units
+      (default 1000): t,utilization,throughput,multiprogramming,blocked,faults.
+
+    USAGE
+        sched_paging --policy rr|srtf|prio [--tq Q] --frames F [--algo POLICY] [--disk D]
+                     [--disks K] [--wss W] [--phase L] [--seed S] [--page-traces F1,F2,...]
+                     [--trace FILE] [--curve FILE] [--every T]
+    - --tq is required for rr. For prio a lower PR is a higher priority. srtf and prio
+      preempt when a process arrives or returns from the disk with a better claim.
+
+    HOW IS IT FAST?
+    - Discrete events: arrivals are taken in arrival order, disk completions from a min-heap,
+      and the clock jumps over idle time, so the cost is one policy lookup per time unit the
+      CPU is busy plus O(log n) per event. Thousands of processes and millions of references
+      run in well under a second.
+    - The policy is a template parameter, inlined into the loop.
+*/
+
+#include <iostream>         // For cin, cout, cerr
+#include <fstream>          // For ofstream (--curve FILE)
+#include <vector>           // For vector (process table of any size)
+#include <deque>            // For deque (Round Robin ready queue)
+#include <queue>            // For priority_queue (ready heap, disk events)
+#include <string>           // For string (--page-traces list)
+#include <algorithm>        // For stable_sort, min, max
+#include <numeric>          // For iota
+#include <functional>       // For greater
+#include <cstring>          // For strcmp
+#include <cstdlib>          // For atoi, atoll, strtoull
+#include <climits>          // For LLONG_MAX
+#include "proc_trace.h"     // For ProcessTable, loadTrace(), argValue()
+#include "page_policies.h"  // For the replacement policies, pageHash(), PageIndex
+#include "page_trace.h"     // For PageTraceReader (--page-traces)
+using namespace std;        // Avoid writing std:: repeatedly
+
+enum CpuPolicy { CPU_RR, CPU_SRTF, CPU_PRIO };
+
+struct PagingConfig {
+    CpuPolicy policy = CPU_RR;
+    long long tq = 0;                      // Round Robin quantum
+    int frames = 0;                        // shared physical frames
+    long long disk = 100;                  // time to read a page
+    int disks = 1;                         // disks serving faults in parallel
+    long long wss = 16, phase = 10000;     // locality model: working set, references per phase
+    unsigned long long seed = 1;
+    long long every = 1000;                // --curve row length
+};
+
+// Where process i's references come from: page numbers < 2^32 in its own address space
+struct ReferenceStreams {
+    vector<vector<long long>> traces;      // --page-traces, pages renumbered 0, 1, ...
+    PagingConfig cfg;
+
+    long long page(int i, long long k) const {  // page of process i's reference number k
+        if (!traces.empty()) {
+            const vector<long long> &t = traces[i % traces.size()];
+            return t[k % t.size()];
+        }
+        long long phase = k / cfg.phase;   // locality model: W pages of this phase, uniformly
+        unsigned long long h = pageHash(cfg.seed * 0x9E3779B97F4A7C15ULL ^ ((unsigned long long)i << 40) ^ k);
+        return (phase * cfg.wss + h % cfg.wss) & 0xFFFFFFFFLL;
+    }
+};
+
+// Results of one simulation
+struct PagingStats {
+    vector<long long> ct, faults, blocked; // per process: completion, faults, time on the disk
+    long long busy = 0, totalFaults = 0, peak = 0;
+    vector<long long> timeAt, busyAt;      // per degree of multiprogramming: time, CPU busy time
+};
+
+// Simulate the processes of pt on one CPU with the paging policy; the curve goes to curve
+template <class Policy>
+void simulate(const ProcessTable &pt, const PagingConfig &cfg, const ReferenceStreams &refs,
+              Policy policy, PagingStats &st, ostream *curve)
+{
+    int n = pt.size();
+    const vector<long long> &art = pt.art, &bt = pt.bt;
+    vector<long long> rem(bt), pos(n, 0);  // CPU time left, references made
+    vector<char> pending(n, 0);            // returning from a fault: its page is already in
+    st.ct.assign(n, 0);
+    st.faults.assign(n, 0);
+    st.blocked.assign(n, 0);
+
+    vector<int> order(n);                  // process indices sorted by arrival time
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](int a, int b) { return art[a] < art[b]; });
+
+    // Ready processes: a FIFO queue for rr, a min-heap of (remaining time or PR, index) otherwise
+    typedef pair<long long, int> Entry;
+    deque<int> fifo;
+    priority_queue<Entry, vector<Entry>, greater<Entry>> heap;
+    auto claim = [&](int i) { return cfg.policy == CPU_SRTF ? rem[i] : pt.pr[i]; };
+    auto makeReady = [&](int i) {
+        if (cfg.policy == CPU_RR) fifo.push_back(i);
+        else heap.push({claim(i), i});
+    };
+    auto readyEmpty = [&]() { return cfg.policy == CPU_RR ? fifo.empty() : heap.empty(); };
+
+    priority_queue<Entry, vector<Entry>, greater<Entry>> io;         // (completion time, process)
+    priority_queue<long long, vector<long long>, greater<long long>> disk; // time each disk is free
+    for (int d = 0; d < cfg.disks; d++) disk.push(0);
+
+    // Time accounting: per degree of multiprogramming, and in --curve rows
+    long long time = n ? art[order[0]] : 0;
+    int inSystem = 0, blocked = 0;
+    long long rowStart = time, rowBusy = 0, rowDom = 0, rowBlocked = 0, rowDone = 0, rowFaults = 0;
+    auto row = [&]() {                     // one --curve row for [rowStart, time)
+        double len = time - rowStart;
+        *curve << time << "," << rowBusy / len << "," << rowDone / len << "," << rowDom / len
+               << "," << rowBlocked / len << "," << rowFaults << "\n";
+        rowStart = time;
+        rowBusy = rowDom = rowBlocked = rowDone = rowFaults = 0;
+    };
+    auto advance = [&](long long until, bool busy) {
+        if ((int)st.timeAt.size() <= inSystem) {
+            st.timeAt.resize(inSystem + 1);
+            st.busyAt.resize(inSystem + 1);
+        }
+        st.timeAt[inSystem] += until - time;
+        if (busy) { st.busyAt[inSystem] += until - time; st.busy += until - time; }
+        while (curve && time < until) {
+            long long end = min(until, rowStart + cfg.every), dt = end - time;
+            rowBusy += busy ? dt : 0;
+            rowDom += inSystem * dt;
+            rowBlocked += blocked * dt;
+            time = end;
+            if (time == rowStart + cfg.every) row();
+        }
+        time = until;
+    };
+
+    int next = 0, completed = 0;           // next arrival in order[], finished processes
+    int cur = -1;                          // process on the CPU (-1 = idle)
+    long long slice = 0;                   // time cur has run since it was dispatched
+
+    while (completed < n) {
+        // Events due now: arrivals, then pages read in
+        while (next < n && art[order[next]] <= time) {
+            int i = order[next++];
+            if (bt[i] <= 0) { st.ct[i] = time; completed++; rowDone++; continue; }
+            inSystem++;
+            st.peak = max<long long>(st.peak, inSystem);
+            makeReady(i);
+        }
+        while (!io.empty() && io.top().first <= time) {
+            makeReady(io.top().second);
+            io.pop();
+            blocked--;
+        }
+
+        // Preemption: the quantum is over, or a ready process has a better claim
+        if (cur != -1) {
+            // (ties go to the lower index, as in sched_engines.h)
+            if (cfg.policy == CPU_RR ? slice == cfg.tq : !heap.empty() && heap.top() < Entry(claim(cur), cur)) {
+                makeReady(cur);
+                cur = -1;
+            }
+        }
+        if (cur == -1) {
+            if (readyEmpty()) {            // idle: jump to the next arrival or disk completion
+                long long nextEvent = min(next < n ? art[order[next]] : LLONG_MAX,
+                                          io.empty() ? LLONG_MAX : io.top().first);
+                if (nextEvent == LLONG_MAX) break;
+                advance(nextEvent, false);
+                continue;
+            }
+            if (cfg.policy == CPU_RR) { cur = fifo.front(); fifo.pop_front(); }
+            else { cur = heap.top().second; heap.pop(); }
+            slice = 0;
+        }
+
+        // One time unit of cur: one page reference, which may fault and block it
+        if (!pending[cur] && policy.access(((long long)cur << 32) | refs.page(cur, pos[cur]))) {
+            long long start = max(time, disk.top()), done = start + cfg.disk;
+            disk.pop();
+            disk.push(done);
+            io.push({done, cur});
+            st.faults[cur]++;
+            st.totalFaults++;
+            st.blocked[cur] += done - time;
+            rowFaults++;
+            blocked++;
+            pending[cur] = 1;
+            cur = -1;
+            continue;
+        }
+        pending[cur] = 0;
+        pos[cur]++;
+        rem[cur]--;
+        slice++;
+        advance(time + 1, true);
+        if (rem[cur] == 0) {
+            st.ct[cur] = time;
+            completed++;
+            rowDone++;
+            inSystem--;
+            cur = -1;
+        }
+    }
+    if (curve && time > rowStart) row();   // the last, shorter row
+}
+
+// Load every --page-traces file, renumbering its pages 0, 1, ...; false on errors
+bool loadStreams(const char *list, const PageTraceSpec &spec, ReferenceStreams &refs)
+{
+    string s = list;
+    for (size_t a = 0; a <= s.size(); ) {
+        size_t b = s.find(',', a);
+        if (b == string::npos) b = s.size();
+        string path = s.substr(a, b - a);
+        PageTraceReader trace(path.c_str(), spec);
+        vector<long long> chunk, &t = *refs.traces.emplace(refs.traces.end());
+        PageIndex<long long> number;
+        number.reset(1024);
+        while (trace.next(chunk))
+            for (long long page : chunk) {
+                long long id = number.find(page);
+                if (id == -1) number.set(page, id = number.size());
+                t.push_back(id);
+            }
+        if (trace.failed) return false;
+        if (t.empty()) { cerr << path << ": empty page trace\n"; return false; }
+        a = b + 1;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    ios::sync_with_stdio(false);                 // faster cin/cout for large inputs
+
+    PagingConfig cfg;
+    const char *policy = argValue(argc, argv, "--policy");
+    const char *tq = argValue(argc, argv, "--tq");
+    const char *frames = argValue(argc, argv, "--frames");
+    const char *algoArg = argValue(argc, argv, "--algo");
+    string algo = algoArg ? algoArg : "lru";
+    bool ok = policy && frames && atoll(frames) > 0 && atoll(frames) <= INT_MAX;
+    if (ok) {
+        cfg.frames = atoll(frames);
+        if (strcmp(policy, "rr") == 0) cfg.policy = CPU_RR;
+        else if (strcmp(policy, "srtf") == 0) cfg.policy = CPU_SRTF;
+        else if (strcmp(policy, "prio") == 0) cfg.policy = CPU_PRIO;
+        else ok = false;
+    }
+    if (ok && cfg.policy == CPU_RR) {            // Round Robin needs a positive quantum
+        if (tq && atoll(tq) > 0) cfg.tq = atoll(tq);
+        else ok = false;
+    }
+    if (const char *s = argValue(argc, argv, "--disk")) cfg.disk = atoll(s);
+    if (const char *s = argValue(argc, argv, "--disks")) cfg.disks = atoi(s);
+    if (const char *s = argValue(argc, argv, "--wss")) cfg.wss = atoll(s);
+    if (const char *s = argValue(argc, argv, "--phase")) cfg.phase = atoll(s);
+    if (const char *s = argValue(argc, argv, "--seed")) cfg.seed = strtoull(s, nullptr, 10);
+    if (const char *s = argValue(argc, argv, "--every")) cfg.every = atoll(s);
+    ok = ok && cfg.disk >= 0 && cfg.disks > 0 && cfg.wss > 0 && cfg.phase > 0 && cfg.every > 0 &&
+         (algo == "fifo" || algo == "lru" || algo == "clock" || algo == "lfu" || algo == "2q" ||
+          algo == "arc" || algo == "lirs");
+    PageTraceSpec spec;                          // --format, --page-size for --page-traces
+    if (!ok || !parsePageTrace(argc, argv, spec)) {
+        cerr << "usage: sched_paging --policy rr|srtf|prio [--tq Q] --frames F\n"
+                "                    [--algo fifo|lru|clock|lfu|2q|arc|lirs] [--disk D] [--disks K]\n"
+                "                    [--wss W] [--phase L] [--seed S] [--page-traces F1,F2,...]\n"
+                "                    [--trace FILE] [--curve FILE] [--every T]\n";
+        return 1;
+    }
+    ReferenceStreams refs;
+    refs.cfg = cfg;
+    if (const char *s = argValue(argc, argv, "--page-traces"))
+        if (!loadStreams(s, spec, refs)) return 1;
+
+    ProcessTable pt;                             // process table: pt.art, pt.bt, pt.pr columns
+    const char *trace = argValue(argc, argv, "--trace");
+    if (trace) {                                 // batch mode: every process comes from the trace file
+        if (!loadTrace(trace, pt)) return 1;
+        if (cfg.policy == CPU_PRIO && !pt.hasPriority()) {
+            cerr << trace << ": trace has no priority column\n";
+            return 1;
+        }
+        if (!pt.hasPriority()) pt.pr.assign(pt.size(), 0);
+    } else {
+        int n;                                   // number of processes
+        cout << "Enter number of processes : ";  // prompt user
+        cin >> n;                                // read number of processes
+        pt.art.resize(n);
+        pt.bt.resize(n);
+        pt.pr.assign(n, 0);
+        for (int i = 0; i < n; i++) {            // read AT, BT (and PR) of every process
+            if (cfg.policy == CPU_PRIO) {
+                cout << "P" << i + 1 << " AT BT Priority : ";
+                cin >> pt.art[i] >> pt.bt[i] >> pt.pr[i];
+            } else {
+                cout << "P" << i + 1 << " AT BT : ";
+                cin >> pt.art[i] >> pt.bt[i];
+            }
+        }
+    }
+    int n = pt.size();                           // number of processes
+    if (n == 0) { cerr << "no processes\n"; return 1; }
+
+    ofstream curveFile;
+    if (const char *c = argValue(argc, argv, "--curve")) {
+        curveFile.open(c);
+        if (!curveFile) { cerr << c << ": cannot create output file\n"; return 1; }
+        curveFile << "t,utilization,throughput,multiprogramming,blocked,faults\n";
+    }
+    ostream *curve = curveFile.is_open() ? &curveFile : nullptr;
+
+    PagingStats st;                              // run the simulation with the chosen policy
+    int f = cfg.frames;
+    if (algo == "fifo") simulate(pt, cfg, refs, FifoPolicy(f), st, curve);
+    else if (algo == "lru") simulate(pt, cfg, refs, LruPolicy(f), st, curve);
+    else if (algo == "clock") simulate(pt, cfg, refs, ClockPolicy(f), st, curve);
+    else if (algo == "lfu") simulate(pt, cfg, refs, LfuPolicy(f), st, curve);
+    else if (algo == "2q") simulate(pt, cfg, refs, TwoQPolicy(f), st, curve);
+    else if (algo == "arc") simulate(pt, cfg, refs, ArcPolicy(f), st, curve);
+    else simulate(pt, cfg, refs, LirsPolicy(f), st, curve);
+
+    const vector<long long> &art = pt.art, &bt = pt.bt, &ct = st.ct;
+    double total_wt = 0, total_tat = 0, total_blocked = 0; // totals for averages
+    long long first = art[0], last = ct[0], references = 0;
+    cout << "\nPID\tAT\tBT\tCT\tTAT\tWT\tFaults\tBlocked\n";
+    for (int i = 0; i < n; i++) {
+        long long tat = ct[i] - art[i];          // TAT = CT - AT
+        long long wt = tat - bt[i] - st.blocked[i]; // WT = TAT - BT - time waiting for the disk
+        total_wt += wt;
+        total_tat += tat;
+        total_blocked += st.blocked[i];
+        references += max(0LL, bt[i]);
+        first = min(first, art[i]);
+        last = max(last, ct[i]);
+        cout << "P" << i + 1 << "\t" << art[i] << "\t" << bt[i] << "\t" << ct[i] << "\t" << tat << "\t"
+             << wt << "\t" << st.faults[i] << "\t" << st.blocked[i] << "\n";
+    }
+
+    long long span = last - first;
+    cout << "\nAverage Waiting Time     : " << total_wt / n << endl;
+    cout << "Average Turn-Around Time : " << total_tat / n << endl;
+    cout << "Average Time Blocked     : " << total_blocked / n << endl;
+    cout << "CPU Utilization          : " << (span > 0 ? 100.0 * st.busy / span : 0.0) << "%" << endl;
+    cout << "Throughput               : " << (span > 0 ? (double)n / span : 0.0) << " processes per time unit" << endl;
+    cout << "Page Faults              : " << st.totalFaults << " (fault rate "
+         << (references ? (double)st.totalFaults / references : 0.0) << ")" << endl;
+    cout << "Peak Multiprogramming    : " << st.peak << endl;
+
+    // Utilization by degree of multiprogramming: the thrashing curve
+    cout << "\nDegree\tTime\tUtil%\n";
+    for (size_t d = 1; d < st.timeAt.size(); d++)
+        if (st.timeAt[d] > 0)
+            cout << d << "\t" << st.timeAt[d] << "\t" << 100.0 * st.busyAt[d] / st.timeAt[d] << "\n";
+
+    return 0;                                    // normal program termination
+}
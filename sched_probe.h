@@ -0,0 +1,200 @@
+/*
+    TOPIC: Scheduler Instrumentation - latency percentiles, context switches, Gantt timeline
+
+    WHAT IS THIS FILE?
+    - Averages hide the slow cases: a scheduler can have a good average waiting time and still
+      make 1 process in 100 wait for ages. This file measures the whole distribution.
+    - Every scheduling engine takes an optional probe and reports each stretch of time a
+      process runs on a CPU:   probe.run(cpu, process, start, end, finished)
+    - NullProbe ignores everything; it is the default, so an engine called without a probe
+      compiles to exactly the code it had before (zero overhead).
+    - SchedProbe records:
+        - waiting, turn-around and response time (first run - arrival) of every process in
+          log-bucketed histograms, to print p50 / p90 / p99 / p99.9 and the maximum
+        - context switches (a CPU starts a different process than the one it ran last)
+        - preemptions (a CPU switches away from a process that has not finished)
+        - optionally, the Gantt chart of the whole run as a compact binary timeline file
+    - The programs turn it on with --stats (print the percentiles) and --timeline FILE.
+
+    LOG-BUCKETED HISTOGRAM (as in HdrHistogram)
+    - Values below 256 get one bucket each. Above that, every power-of-two range [2^k, 2^(k+1))
+      is cut into 128 equal buckets, so a bucket is never wider than 1/128 of its values.
+    - ~8000 buckets cover every 64-bit value; recording is a few bit operations, and any
+      percentile is read back with < 1% relative error, whatever the number of processes.
+
+    TIMELINE FILE FORMAT
+    - "GNT1" magic, then uint32 number of CPUs, then one record per run of a process:
+          cpu, process index, gap since the previous run on that CPU ended, run length
+      each written as a LEB128 varint (7 bits per byte; the gap is zigzag-encoded).
+    - Consecutive runs of the same process on a CPU are merged (run-length encoding), so a
+      record is usually 4-6 bytes. timeline_dump.cpp prints the file as text.
+*/
+
+#ifndef SCHED_PROBE_H
+#define SCHED_PROBE_H
+
+#include <vector>       // std::vector
+#include <cstdio>       // std::FILE, std::fopen, std::fwrite
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <iostream>     // std::ostream, std::cerr
+#include <algorithm>    // std::min, std::max
+#include <climits>      // LLONG_MIN
+
+// The default probe: records nothing and costs nothing
+struct NullProbe {
+    static constexpr bool enabled = false;
+    void run(int, int, long long, long long, bool) {}
+};
+
+// HDR-style histogram of non-negative values with 1/128 relative precision
+class LogHistogram {
+public:
+    static const int SUB = 8;                   // 2^SUB exact buckets, then 2^(SUB-1) per power of two
+
+    LogHistogram() : count(SUB_COUNT + (64 - SUB) * HALF, 0) {}
+
+    void record(long long v) {
+        if (v < 0) v = 0;
+        count[index(v)]++;
+        total++;
+        sum += v;
+        hi = std::max(hi, v);
+    }
+    long long size() const { return total; }
+    double mean() const { return total ? sum / total : 0; }
+    long long max() const { return hi; }
+
+    // Smallest value v such that at least p% of the recorded values are <= v (to bucket precision)
+    long long percentile(double p) const {
+        if (total == 0) return 0;
+        long long rank = (long long)(p / 100 * total + 0.999999);
+        if (rank < 1) rank = 1;
+        long long seen = 0;
+        for (size_t b = 0; b < count.size(); b++) {
+            seen += count[b];
+            if (seen >= rank) return std::min(hi, upper(b));
+        }
+        return hi;
+    }
+
+private:
+    static const long long SUB_COUNT = 1LL << SUB;  // values 0 .. 255 are exact
+    static const long long HALF = SUB_COUNT / 2;    // buckets per power of two above that
+    std::vector<long long> count;               // number of values in each bucket
+    long long total = 0, hi = 0;                // number of values, largest value
+    double sum = 0;                             // for the mean
+
+    static size_t index(long long v) {
+        if (v < SUB_COUNT) return v;
+        int msb = 63 - __builtin_clzll(v);      // v is in [2^msb, 2^(msb+1))
+        int shift = msb - (SUB - 1);            // keep the top SUB bits of v
+        return SUB_COUNT + (shift - 1) * HALF + ((v >> shift) - HALF);
+    }
+    static long long upper(size_t b) {          // largest value that falls in bucket b
+        if ((long long)b < SUB_COUNT) return b;
+        long long shift = (b - SUB_COUNT) / HALF + 1, top = (b - SUB_COUNT) % HALF + HALF;
+        return ((top + 1) << shift) - 1;
+    }
+};
+
+// The recording probe (see the top of this file)
+class SchedProbe {
+public:
+    static constexpr bool enabled = true;
+    long long contextSwitches = 0;              // CPU started a different process
+    long long preemptions = 0;                  // ... while the previous one was not finished
+    LogHistogram waiting, turnaround, response; // filled by finish()
+
+    // n processes on 'cpus' CPUs; timelinePath = nullptr for no timeline file
+    SchedProbe(int n, int cpus = 1, const char *timelinePath = nullptr)
+        : firstRun(n, LLONG_MIN), last(cpus) {
+        if (!timelinePath) return;
+        out = std::fopen(timelinePath, "wb");
+        if (!out) { std::cerr << timelinePath << ": cannot create timeline file\n"; failed = true; return; }
+        std::uint32_t k = cpus;
+        std::fwrite("GNT1", 1, 4, out);
+        std::fwrite(&k, sizeof k, 1, out);
+    }
+    ~SchedProbe() {
+        if (!out) return;
+        for (size_t c = 0; c < last.size(); c++) flush(c);
+        std::fclose(out);
+    }
+    bool ok() const { return !failed; }
+
+    // Process pid ran on cpu from start to end; finished = it completed at end
+    void run(int cpu, int pid, long long start, long long end, bool finished) {
+        if (end <= start) return;
+        Cpu &c = last[cpu];
+        if (firstRun[pid] == LLONG_MIN) firstRun[pid] = start;
+        if (c.pid != pid) {                     // a different process: context switch
+            if (c.pid >= 0) {
+                contextSwitches++;
+                if (!c.finished) preemptions++;
+            }
+            if (out) { flush(cpu); c.start = start; }
+            c.pid = pid;
+        } else if (out && start != c.end) {     // same process after a gap: new record
+            flush(cpu);
+            c.start = start;
+        }
+        c.end = end;
+        c.finished = finished;
+    }
+
+    // After the run: put every process's waiting, turn-around and response time in the histograms
+    void finish(const std::vector<long long> &art, const std::vector<long long> &bt,
+                const std::vector<long long> &ct) {
+        for (size_t i = 0; i < ct.size(); i++) {
+            waiting.record(ct[i] - art[i] - bt[i]);
+            turnaround.record(ct[i] - art[i]);
+            response.record(firstRun[i] == LLONG_MIN ? 0 : firstRun[i] - art[i]);
+        }
+    }
+
+    // Print the percentile table and the counters
+    void report(std::ostream &os) const {
+        os << "\nMetric\t\tp50\tp90\tp99\tp99.9\tmax\n";
+        row(os, "Waiting\t", waiting);
+        row(os, "Turn-Around", turnaround);
+        row(os, "Response", response);
+        os << "\nContext Switches         : " << contextSwitches << "\n";
+        os << "Preemptions              : " << preemptions << "\n";
+    }
+
+private:
+    struct Cpu {                                // what each CPU ran last
+        int pid = -1;                           // -1 = nothing yet
+        long long start = 0, end = 0;           // current (not yet written) timeline record
+        long long written = 0;                  // end of the last record written for this CPU
+        bool finished = true;
+    };
+    std::vector<long long> firstRun;            // first time each process ran (LLONG_MIN = never)
+    std::vector<Cpu> last;
+    std::FILE *out = nullptr;                   // timeline file
+    bool failed = false;
+
+    static void row(std::ostream &os, const char *name, const LogHistogram &h) {
+        os << name << "\t" << h.percentile(50) << "\t" << h.percentile(90) << "\t"
+           << h.percentile(99) << "\t" << h.percentile(99.9) << "\t" << h.max() << "\n";
+    }
+    void varint(std::uint64_t v) {              // LEB128: 7 bits per byte, high bit = more follow
+        unsigned char buf[10];
+        int k = 0;
+        do { buf[k] = v & 0x7F; v >>= 7; if (v) buf[k] |= 0x80; k++; } while (v);
+        std::fwrite(buf, 1, k, out);
+    }
+    void flush(size_t cpu) {                    // write the pending record of this CPU
+        Cpu &c = last[cpu];
+        if (c.pid < 0 || c.end <= c.start) return;
+        long long gap = c.start - c.written;
+        varint(cpu);
+        varint(c.pid);
+        varint(gap >= 0 ? (std::uint64_t)gap << 1 : ((std::uint64_t)(-gap) << 1) - 1); // zigzag
+        varint(c.end - c.start);
+        c.written = c.end;
+        c.start = c.end;                        // nothing pending
+    }
+};
+
+#endif
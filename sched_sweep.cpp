@@ -0,0 +1,239 @@
+/*
+    TOPIC: Scheduling Policy Sweep - every policy and parameter on one workload, in parallel
+
+    WHAT IS A SWEEP?
+    - To choose a CPU scheduling policy, the same workload is run through FCFS, SJF, SRTF,
+      priority and Round Robin, at several time quanta and numbers of CPUs, and the results
+      are compared side by side.
+    - Running each program by hand (fcfs, srtf, rrobin --tq 2, rrobin --tq 4, ...) loads the
+      trace again every time and uses one core.
+
+    WHAT DOES THIS PROGRAM DO?
+    - Loads the trace once into a ProcessTable (see proc_trace.h).
+    - Builds every (policy, CPUs, quantum) combination and runs them on a pool of threads.
+      All threads read the same process table; each job only writes its own results.
+    - With 1 CPU the single-CPU engines from sched_engines.h are used (fcfs, nonPreemptive,
+      srtfEventDriven, priorityPreemptive, roundRobin); with more CPUs, smpSchedule().
+    - Writes one comparison table, one row per combination, as CSV or JSON.
+
+    USAGE
+        sched_sweep --trace FILE [--policies fcfs,sjf,srtf,prio,rr] [--tq 1,2,4,8]
+                    [--cpus 1,2,4] [--balance none|push|steal] [--interval T]
+                    [--threads N] [--format csv|json] [--out FILE]
+    - prio is preemptive priority (as in priority_prem) and needs a PR column in the trace.
+    - --tq only applies to rr; --balance and --interval only to runs with more than 1 CPU.
+    - Defaults: all five policies, tq 1,2,4,8,16, 1 CPU, no balancing, one thread per core.
+    - Build with threads enabled: g++ -O2 -pthread sched_sweep.cpp -o sched_sweep
+
+    OUTPUT COLUMNS
+    - policy, cpus, tq, balance: the combination (tq is empty/null except for rr)
+    - avg_wt, avg_tat, max_wt: waiting and turn-around times
+    - makespan: last completion - first arrival; throughput: processes per time unit
+    - utilization: busy CPU time / (cpus * makespan); migrations: SMP runs only
+
+    HOW DOES IT SCALE?
+    - Jobs are handed out one at a time from an atomic counter, so a thread that finishes a
+      short job immediately takes the next one; nothing is locked while a job runs.
+    - The process table is shared, not copied, so adding threads adds no memory for the input.
+*/
+
+#include <iostream>         // For cout, cerr
+#include <fstream>          // For ofstream (--out FILE)
+#include <vector>           // For vector
+#include <string>           // For string
+#include <thread>           // For thread (worker pool)
+#include <atomic>           // For atomic<int> (next job to run)
+#include <chrono>           // For steady_clock (elapsed time)
+#include <algorithm>        // For min, max
+#include <cstring>          // For strcmp
+#include <cstdlib>          // For atoi, atoll, strtoll
+#include "proc_trace.h"     // For ProcessTable, loadTrace(), argValue()
+#include "sched_engines.h"  // For the scheduling engines
+using namespace std;        // Avoid writing std:: repeatedly
+
+const char *POLICY_NAMES[] = {"fcfs", "sjf", "srtf", "prio", "rr"}; // indexed by SmpPolicy
+const char *BALANCE_NAMES[] = {"none", "push", "steal"};           // indexed by SmpBalance
+
+// One combination to run, and its results
+struct Job {
+    SmpConfig cfg;                          // policy, CPUs, quantum, balancing
+    double avgWt = 0, avgTat = 0;           // averages over all processes
+    long long maxWt = 0, makespan = 0;      // worst waiting time, first arrival to last completion
+    double throughput = 0, utilization = 0; // processes per time unit, busy share of the CPUs
+    long long migrations = 0;               // SMP only
+};
+
+// Run one job on the shared (read-only) process table
+void runJob(const ProcessTable &pt, Job &job)
+{
+    int n = pt.size();
+    const SmpConfig &cfg = job.cfg;
+    vector<long long> ct(n);                // this job's own completion times
+
+    if (cfg.cpus == 1) {                    // single CPU: the dedicated engines
+        if (cfg.policy == SMP_FCFS) fcfs(arrivalOrder(pt.art), pt.art, pt.bt, ct);
+        else if (cfg.policy == SMP_SJF) nonPreemptive(pt.art, pt.bt, pt.bt, ct);
+        else if (cfg.policy == SMP_SRTF) srtfEventDriven(pt.art, pt.bt, ct);
+        else if (cfg.policy == SMP_PRIO) priorityPreemptive(pt.art, pt.bt, pt.pr, 0, ct);
+        else roundRobin(pt.art, pt.bt, cfg.tq, ct);
+    } else {
+        SmpStats st;
+        smpSchedule(pt.art, pt.bt, pt.pr, cfg, ct, st);
+        job.migrations = st.migrations;
+    }
+
+    double sumWt = 0, sumTat = 0, busy = 0;
+    long long first = 0, last = 0;
+    for (int i = 0; i < n; i++) {
+        long long tat = ct[i] - pt.art[i], wt = tat - pt.bt[i];
+        sumWt += wt;
+        sumTat += tat;
+        busy += pt.bt[i];
+        job.maxWt = max(job.maxWt, wt);
+        if (i == 0 || pt.art[i] < first) first = pt.art[i];
+        if (i == 0 || ct[i] > last) last = ct[i];
+    }
+    job.avgWt = n ? sumWt / n : 0;
+    job.avgTat = n ? sumTat / n : 0;
+    job.makespan = last - first;
+    job.throughput = job.makespan > 0 ? n / (double)job.makespan : 0;
+    job.utilization = job.makespan > 0 ? busy / ((double)cfg.cpus * job.makespan) : 0;
+}
+
+// Parse "a,b,c" into positive numbers; false on anything else
+bool parseList(const char *s, vector<long long> &out)
+{
+    out.clear();
+    while (*s) {
+        char *end;
+        long long v = strtoll(s, &end, 10);
+        if (end == s || v <= 0 || (*end && *end != ',')) return false;
+        out.push_back(v);
+        s = *end ? end + 1 : end;
+    }
+    return !out.empty();
+}
+
+// Write the comparison table
+void writeTable(ostream &out, const vector<Job> &jobs, bool json)
+{
+    out.precision(10);
+    if (json) out << "[\n";
+    else out << "policy,cpus,tq,balance,avg_wt,avg_tat,max_wt,makespan,throughput,utilization,migrations\n";
+    for (size_t j = 0; j < jobs.size(); j++) {
+        const Job &r = jobs[j];
+        bool rr = r.cfg.policy == SMP_RR;
+        const char *bal = BALANCE_NAMES[r.cfg.cpus > 1 ? r.cfg.balance : BALANCE_NONE];
+        if (json) {
+            out << "  {\"policy\": \"" << POLICY_NAMES[r.cfg.policy] << "\", \"cpus\": " << r.cfg.cpus
+                << ", \"tq\": ";
+            if (rr) out << r.cfg.tq; else out << "null";
+            out << ", \"balance\": \"" << bal << "\", \"avg_wt\": " << r.avgWt
+                << ", \"avg_tat\": " << r.avgTat << ", \"max_wt\": " << r.maxWt
+                << ", \"makespan\": " << r.makespan << ", \"throughput\": " << r.throughput
+                << ", \"utilization\": " << r.utilization << ", \"migrations\": " << r.migrations
+                << "}" << (j + 1 < jobs.size() ? "," : "") << "\n";
+        } else {
+            out << POLICY_NAMES[r.cfg.policy] << "," << r.cfg.cpus << ",";
+            if (rr) out << r.cfg.tq;
+            out << "," << bal << "," << r.avgWt << "," << r.avgTat << "," << r.maxWt << ","
+                << r.makespan << "," << r.throughput << "," << r.utilization << "," << r.migrations << "\n";
+        }
+    }
+    if (json) out << "]\n";
+}
+
+int main(int argc, char *argv[])
+{
+    const char *usage = "usage: sched_sweep --trace FILE [--policies fcfs,sjf,srtf,prio,rr] [--tq Q1,Q2,...]\n"
+                        "                   [--cpus K1,K2,...] [--balance none|push|steal] [--interval T]\n"
+                        "                   [--threads N] [--format csv|json] [--out FILE]\n";
+    const char *trace = argValue(argc, argv, "--trace");
+    if (!trace) { cerr << usage; return 1; }
+
+    // Options
+    vector<int> policies;                   // SmpPolicy values to run
+    const char *ps = argValue(argc, argv, "--policies");
+    string list = ps ? ps : "fcfs,sjf,srtf,prio,rr";
+    for (size_t a = 0; a <= list.size(); ) {
+        size_t b = list.find(',', a);
+        if (b == string::npos) b = list.size();
+        string name = list.substr(a, b - a);
+        int p = 0;
+        while (p < 5 && name != POLICY_NAMES[p]) p++;
+        if (p == 5) { cerr << "unknown policy: " << name << "\n" << usage; return 1; }
+        policies.push_back(p);
+        a = b + 1;
+    }
+
+    vector<long long> quanta = {1, 2, 4, 8, 16}, cpus = {1};
+    const char *tq = argValue(argc, argv, "--tq"), *cp = argValue(argc, argv, "--cpus");
+    if ((tq && !parseList(tq, quanta)) || (cp && !parseList(cp, cpus))) { cerr << usage; return 1; }
+
+    SmpBalance balance = BALANCE_NONE;
+    if (const char *b = argValue(argc, argv, "--balance")) {
+        if (strcmp(b, "push") == 0) balance = BALANCE_PUSH;
+        else if (strcmp(b, "steal") == 0) balance = BALANCE_STEAL;
+        else if (strcmp(b, "none") != 0) { cerr << usage; return 1; }
+    }
+    long long interval = 1;
+    if (const char *iv = argValue(argc, argv, "--interval")) interval = atoll(iv);
+
+    int threads = max(1u, thread::hardware_concurrency()); // 0 if unknown
+    if (const char *t = argValue(argc, argv, "--threads")) threads = atoi(t);
+    if (threads <= 0 || interval <= 0) { cerr << usage; return 1; }
+
+    const char *format = argValue(argc, argv, "--format");
+    bool json = format && strcmp(format, "json") == 0;
+    if (format && !json && strcmp(format, "csv") != 0) { cerr << usage; return 1; }
+
+    // The shared process table
+    ProcessTable pt;
+    if (!loadTrace(trace, pt)) return 1;
+    bool wantsPrio = false;
+    for (int p : policies) wantsPrio |= (p == SMP_PRIO);
+    if (wantsPrio && !pt.hasPriority()) {
+        cerr << trace << ": trace has no priority column (needed by prio)\n";
+        return 1;
+    }
+    if (!pt.hasPriority()) pt.pr.assign(pt.size(), 0);
+
+    // Every combination
+    vector<Job> jobs;
+    for (long long k : cpus)
+        for (int p : policies) {
+            Job job;
+            job.cfg.cpus = k;
+            job.cfg.policy = (SmpPolicy)p;
+            job.cfg.balance = balance;
+            job.cfg.interval = interval;
+            if (p == SMP_RR)
+                for (long long q : quanta) { job.cfg.tq = q; jobs.push_back(job); }
+            else jobs.push_back(job);
+        }
+
+    // Thread pool: each worker takes the next job until none are left
+    auto start = chrono::steady_clock::now();
+    atomic<int> nextJob(0);
+    vector<thread> pool;
+    threads = min<int>(threads, jobs.size());
+    for (int t = 0; t < threads; t++)
+        pool.emplace_back([&]() {
+            for (int j; (j = nextJob.fetch_add(1)) < (int)jobs.size(); )
+                runJob(pt, jobs[j]);
+        });
+    for (thread &t : pool) t.join();
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Results
+    if (const char *path = argValue(argc, argv, "--out")) {
+        ofstream out(path);
+        if (!out) { cerr << path << ": cannot create output file\n"; return 1; }
+        writeTable(out, jobs, json);
+    } else {
+        writeTable(cout, jobs, json);
+    }
+    cerr << jobs.size() << " runs of " << pt.size() << " processes on " << threads
+         << " threads in " << secs << " s\n";
+    return 0;
+}
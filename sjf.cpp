@@ -7,71 +7,73 @@
     - Good average waiting time for many workloads, but can starve long jobs.
 
     WHAT DOES THIS PROGRAM DO?
-    - Reads number of processes and for each process reads Arrival Time (AT) and Burst Time (BT).
+    - Reads number of processes and for each process reads Arrival Time (AT) and Burst Time (BT),
+      or reads them all from a trace file (sjf --trace FILE, see proc_trace.h).
     - Simulates non-preemptive SJF: at each time, picks the arrived process with smallest BT.
     - Computes Completion Time (CT), Turn-Around Time (TAT) and Waiting Time (WT).
     - Prints per-process times and average WT and TAT.
+    - --stats also prints waiting, turn-around and response time percentiles, context switches
+      and preemptions; --timeline FILE saves the Gantt chart (see sched_probe.h).
+
+    HOW?
+    - Uses the shared non-preemptive engine in sched_engines.h with key = burst time:
+      arrived processes go into a min-heap and idle gaps are skipped, so it runs in O(n log n).
 */
 
-#include <iostream>     // For cin, cout
-using namespace std;    // Avoid writing std:: repeatedly
+#include <iostream>         // For cin, cout
+#include <vector>           // For vector (process table of any size)
+#include "sched_engines.h"  // For nonPreemptive()
+#include "proc_trace.h"     // For ProcessTable, loadTrace()
+using namespace std;        // Avoid writing std:: repeatedly
 
-int main()
+int main(int argc, char *argv[])
 {
-    int n;                                 // number of processes
-    cout << "Enter number of processes : "; // prompt user
-    cin >> n;                              // read number of processes
+    ios::sync_with_stdio(false);           // faster cin/cout for large inputs
 
-    int pid[50], art[50], bt[50];          // pid: process id, art: arrival time, bt: burst time
-    int ct[50], tat[50], wt[50], done[50] = {0}; // ct: completion time, tat: turnaround, wt: waiting, done: finished flag
+    ProcessTable pt;                       // process table: pt.art = arrival time, pt.bt = burst time
+    const char *trace = argValue(argc, argv, "--trace");
+    if (trace) {                           // batch mode: every process comes from the trace file
+        if (!loadTrace(trace, pt)) return 1;
+    } else {
+        int n;                                 // number of processes
+        cout << "Enter number of processes : "; // prompt user
+        cin >> n;                              // read number of processes
+        pt.art.resize(n);
+        pt.bt.resize(n);
 
-    // Read input for each process
-    for(int i = 0; i < n; i++){
-        pid[i] = i + 1;                    // assign process id (P1, P2, ...)
-        cout << "P" << pid[i] << " At BT : "; // prompt for arrival time and burst time
-        cin >> art[i] >> bt[i];            // read arrival time and burst time
+        // Read input for each process
+        for(int i = 0; i < n; i++){
+            cout << "P" << i + 1 << " At BT : "; // prompt for arrival time and burst time
+            cin >> pt.art[i] >> pt.bt[i];      // read arrival time and burst time
+        }
     }
 
-    int time = 0, completed = 0;           // time: current time, completed: count of finished processes
+    int n = pt.size();                     // number of processes
+    const vector<long long> &art = pt.art, &bt = pt.bt; // short names for the AT and BT columns
+    vector<long long> ct(n), tat(n), wt(n); // ct: completion time, tat: turnaround, wt: waiting
 
-    // Main loop: continue until all processes are completed
-    while (completed < n) {
-        int idx = -1;                      // index of process selected to run next
-        int shortest = INT_MAX;           // hold shortest burst time found (initialize large)
+    const char *timeline = argValue(argc, argv, "--timeline"); // binary Gantt chart (sched_probe.h)
+    bool stats = argFlag(argc, argv, "--stats");              // print latency percentiles too
+    SchedProbe probe(stats || timeline ? n : 0, 1, timeline); // sees every run when enabled
+    if (!probe.ok()) return 1;
 
-        // Find the arrived, not-yet-done process with smallest burst time
-        for (int i = 0; i < n; i++) {
-            if (!done[i] && art[i] <= time) {   // process has arrived and not finished
-                if (bt[i] < shortest) {        // if this process has smaller burst time
-                    shortest = bt[i];          // update shortest
-                    idx = i;                   // update selected index
-                }
-            }
-        }
+    if (stats || timeline) nonPreemptive(art, bt, bt, ct, probe);
+    else nonPreemptive(art, bt, bt, ct);   // SJF: the selection key is the burst time
 
-        if (idx == -1) {                    // no process is ready at current time
-            time++;                         // CPU idle: advance time
-            continue;                       // retry selection
-        }
-
-        // Execute selected process non-preemptively
-        time += bt[idx];                    // advance current time by its burst time
-        ct[idx] = time;                     // completion time for selected process
-        tat[idx] = ct[idx] - art[idx];      // turnaround time = completion - arrival
-        wt[idx] = tat[idx] - bt[idx];       // waiting time = turnaround - burst
-        done[idx] = 1;                      // mark process as finished
-        completed++;                        // increment completed count
+    for (int i = 0; i < n; i++) {
+        tat[i] = ct[i] - art[i];           // turnaround time = completion - arrival
+        wt[i] = tat[i] - bt[i];            // waiting time = turnaround - burst
     }
 
     // Print results table
     cout << "\nPID\tAT\tBT\tCT\tTAT\tWT\n";
     for (int i = 0; i < n; i++) {
-        cout << "P" << pid[i] << "\t" << art[i] << "\t" << bt[i] << "\t"
-             << ct[i] << "\t" << tat[i] << "\t" << wt[i] << endl;
+        cout << "P" << i + 1 << "\t" << art[i] << "\t" << bt[i] << "\t"
+             << ct[i] << "\t" << tat[i] << "\t" << wt[i] << "\n";
     }
 
     // Compute and print averages
-    float total_wt = 0, total_tat = 0;
+    double total_wt = 0, total_tat = 0;
     for (int i = 0; i < n; i++) {
         total_wt += wt[i];                 // accumulate waiting times
         total_tat += tat[i];               // accumulate turnaround times
@@ -79,6 +81,10 @@ int main()
 
     cout << "\nAverage Waiting Time     : " << total_wt / n << endl;
     cout << "Average Turn-Around Time : " << total_tat / n << endl;
+    if (stats) {                                 // latency percentiles, context switches, preemptions
+        probe.finish(art, bt, ct);
+        probe.report(cout);
+    }
 
     return 0;                              // successful termination
 }
@@ -0,0 +1,151 @@
+/*
+    TOPIC: Multi-CPU (SMP) Scheduling with Per-CPU Run Queues and Load Balancing
+
+    WHAT IS SMP SCHEDULING?
+    - A symmetric multiprocessor (SMP) has k identical CPUs sharing the same processes.
+    - Like Linux, each CPU here keeps its own run queue and schedules it on its own
+      (FCFS, SJF, SRTF, preemptive priority or Round Robin).
+    - Queues can get out of balance (one CPU busy with a long queue while another sits idle),
+      so a load balancer moves waiting processes between CPUs. Each move is a migration:
+        push  -> every few time units, push processes from the busiest CPU to the least loaded
+        steal -> a CPU that runs out of work steals a process from the busiest queue
+
+    WHAT DOES THIS PROGRAM DO?
+    - Reads n processes with Arrival Time (AT), Burst Time (BT) and Priority (PR),
+      or reads them all from a trace file (--trace FILE, see proc_trace.h).
+    - Simulates k CPUs with smpSchedule() from sched_engines.h.
+    - Prints per-process times (and the CPU each process finished on), average WT and TAT,
+      then per-CPU utilization and migration counts.
+
+    USAGE
+        smp_sched --cpus K --policy fcfs|sjf|srtf|prio|rr [--tq Q] [--balance none|push|steal]
+                  [--interval T] [--trace FILE] [--stats] [--timeline FILE]
+    - --tq is required for rr; --interval (default 1) is the time between push-migration passes.
+    - With --cpus 1 the results match fcfs, sjf, srtf, priority_prem and rrobin.
+    - --stats also prints waiting, turn-around and response time percentiles, context switches
+      and preemptions; --timeline FILE saves the Gantt chart (see sched_probe.h).
+*/
+
+#include <iostream>         // For cin, cout, cerr
+#include <vector>           // For vector (process table of any size)
+#include <cstring>          // For strcmp
+#include <cstdlib>          // For atoi, atoll
+#include "proc_trace.h"     // For ProcessTable, loadTrace(), argValue()
+#include "sched_engines.h"  // For smpSchedule()
+using namespace std;        // Avoid writing std:: repeatedly
+
+int main(int argc, char *argv[])
+{
+    ios::sync_with_stdio(false);                 // faster cin/cout for large inputs
+
+    SmpConfig cfg;                               // number of CPUs, policy, balancing
+    const char *cpus = argValue(argc, argv, "--cpus");
+    const char *policy = argValue(argc, argv, "--policy");
+    const char *balance = argValue(argc, argv, "--balance");
+    const char *tq = argValue(argc, argv, "--tq");
+    const char *interval = argValue(argc, argv, "--interval");
+
+    bool ok = cpus && policy && atoi(cpus) > 0;
+    if (ok) {
+        cfg.cpus = atoi(cpus);
+        if (strcmp(policy, "fcfs") == 0) cfg.policy = SMP_FCFS;
+        else if (strcmp(policy, "sjf") == 0) cfg.policy = SMP_SJF;
+        else if (strcmp(policy, "srtf") == 0) cfg.policy = SMP_SRTF;
+        else if (strcmp(policy, "prio") == 0) cfg.policy = SMP_PRIO;
+        else if (strcmp(policy, "rr") == 0) cfg.policy = SMP_RR;
+        else ok = false;
+    }
+    if (ok && balance) {
+        if (strcmp(balance, "none") == 0) cfg.balance = BALANCE_NONE;
+        else if (strcmp(balance, "push") == 0) cfg.balance = BALANCE_PUSH;
+        else if (strcmp(balance, "steal") == 0) cfg.balance = BALANCE_STEAL;
+        else ok = false;
+    }
+    if (ok && cfg.policy == SMP_RR) {            // Round Robin needs a positive quantum
+        if (tq && atoll(tq) > 0) cfg.tq = atoll(tq);
+        else ok = false;
+    }
+    if (ok && interval) {                        // push migration period
+        if (atoll(interval) > 0) cfg.interval = atoll(interval);
+        else ok = false;
+    }
+    if (!ok) {
+        cerr << "usage: smp_sched --cpus K --policy fcfs|sjf|srtf|prio|rr [--tq Q]\n"
+                "                 [--balance none|push|steal] [--interval T] [--trace FILE]\n"
+                "                 [--stats] [--timeline FILE]\n";
+        return 1;
+    }
+
+    ProcessTable pt;                             // process table: pt.art, pt.bt, pt.pr columns
+    const char *trace = argValue(argc, argv, "--trace");
+    if (trace) {                                 // batch mode: every process comes from the trace file
+        if (!loadTrace(trace, pt)) return 1;
+        if (cfg.policy == SMP_PRIO && !pt.hasPriority()) {
+            cerr << trace << ": trace has no priority column\n";
+            return 1;
+        }
+        if (!pt.hasPriority()) pt.pr.assign(pt.size(), 0);
+    } else {
+        int n;                                   // number of processes
+        cout << "Enter number of processes : ";  // prompt user
+        cin >> n;                                // read number of processes
+        pt.art.resize(n);
+        pt.bt.resize(n);
+        pt.pr.resize(n);
+
+        for (int i = 0; i < n; i++) {            // read AT, BT, PR of every process
+            cout << "P" << i + 1 << " AT BT Priority : ";
+            cin >> pt.art[i] >> pt.bt[i] >> pt.pr[i];
+        }
+    }
+
+    int n = pt.size();                           // number of processes
+    const vector<long long> &art = pt.art, &bt = pt.bt; // short names for the AT and BT columns
+    vector<long long> ct(n), tat(n), wt(n);      // completion, turnaround and waiting times
+    SmpStats st;                                 // per-CPU busy time and migrations
+
+    const char *timeline = argValue(argc, argv, "--timeline"); // binary Gantt chart (sched_probe.h)
+    bool stats = argFlag(argc, argv, "--stats");              // print latency percentiles too
+    SchedProbe probe(stats || timeline ? n : 0, cfg.cpus, timeline); // sees every run when enabled
+    if (!probe.ok()) return 1;
+
+    if (stats || timeline) smpSchedule(art, bt, pt.pr, cfg, ct, st, probe);
+    else smpSchedule(art, bt, pt.pr, cfg, ct, st); // run the simulation, fills ct[] and st
+
+    double total_wt = 0, total_tat = 0;          // totals for averages (double: millions of rows)
+    long long first = 0, last = 0;               // first arrival and last completion
+    for (int i = 0; i < n; i++) {
+        tat[i] = ct[i] - art[i];                 // TAT = CT - AT
+        wt[i] = tat[i] - bt[i];                  // WT = TAT - BT
+        total_wt += wt[i];
+        total_tat += tat[i];
+        if (i == 0 || art[i] < first) first = art[i];
+        if (i == 0 || ct[i] > last) last = ct[i];
+    }
+
+    // Per-process table
+    cout << "\nPID\tAT\tBT\tCT\tTAT\tWT\tCPU\n";
+    for (int i = 0; i < n; i++) {
+        cout << "P" << i + 1 << "\t" << art[i] << "\t" << bt[i] << "\t" << ct[i] << "\t"
+             << tat[i] << "\t" << wt[i] << "\t" << st.cpuOf[i] << "\n";
+    }
+
+    cout << "\nAverage Waiting Time     : " << total_wt / n << endl;
+    cout << "Average Turn-Around Time : " << total_tat / n << endl;
+
+    // Per-CPU table: utilization = busy time / (last completion - first arrival)
+    long long span = last - first;
+    cout << "\nCPU\tBusy\tUtil%\tDone\tMigIn\tMigOut\n";
+    for (int c = 0; c < cfg.cpus; c++) {
+        cout << c << "\t" << st.busy[c] << "\t"
+             << (span > 0 ? 100.0 * st.busy[c] / span : 0.0) << "\t" << st.ran[c] << "\t"
+             << st.migIn[c] << "\t" << st.migOut[c] << "\n";
+    }
+    cout << "\nTotal Migrations         : " << st.migrations << endl;
+    if (stats) {                                 // latency percentiles, context switches, preemptions
+        probe.finish(art, bt, ct);
+        probe.report(cout);
+    }
+
+    return 0;                                    // normal program termination
+}
@@ -7,79 +7,76 @@
     - If a new process arrives with a smaller remaining time than the running process, preemption occurs.
 
     WHAT DOES THIS PROGRAM DO?
-    - Reads n processes with Arrival Time (AT) and Burst Time (BT).
-    - Simulates SRTF with a unit-time loop (preemptive).
+    - Reads n processes with Arrival Time (AT) and Burst Time (BT),
+      or reads them all from a trace file (srtf --trace FILE, see proc_trace.h).
+    - Simulates SRTF as a discrete-event simulation (preemptive), with srtfEventDriven()
+      from sched_engines.h.
     - Computes Completion Time (CT), Turn-Around Time (TAT), and Waiting Time (WT).
     - Prints per-process times and average WT and TAT.
+    - --stats also prints waiting, turn-around and response time percentiles, context switches
+      and preemptions; --timeline FILE saves the Gantt chart (see sched_probe.h).
+
+    WHY EVENT-DRIVEN?
+    - The choice of process can only change when a new process arrives or the running one finishes.
+    - So instead of ticking time by 1 unit, we jump straight to the next arrival or completion.
+    - Ready processes sit in a min-heap keyed on (remaining time, index), so each decision is O(log n).
+    - Total cost is O(n log n) no matter how large the burst times are (times are 64-bit).
 */
 
-#include <iostream>     // For cin, cout
-using namespace std;    // Avoid writing std:: repeatedly
+#include <iostream>         // For cin, cout
+#include <vector>           // For vector (process table of any size)
+#include "proc_trace.h"     // For ProcessTable, loadTrace()
+#include "sched_engines.h"  // For srtfEventDriven()
+using namespace std;        // Avoid writing std:: repeatedly
 
-int main()
+int main(int argc, char *argv[])
 {
-    int n;                                 // number of processes
-    cout << "Enter number of processes : "; // prompt user
-    cin >> n;                              // read number of processes
-
-    int pid[50], art[50], bt[50], rt[50];  // pid: process id, art: arrival time, bt: burst time, rt: remaining time
-    int ct[50], tat[50], wt[50];           // ct: completion time, tat: turnaround time, wt: waiting time
-
-    // Input block: read Arrival Time and Burst Time, initialize remaining time
-    for (int i = 0; i < n; i++) {
-        pid[i] = i + 1;                    // assign process id P1..Pn
-        cout << "P" << pid[i] << " AT BT : "; // prompt for AT and BT of process i
-        cin >> art[i] >> bt[i];            // read arrival time and burst time
-        rt[i] = bt[i];                     // remaining time initially equals burst time
-    }
-
-    int completed = 0;                     // number of completed processes
-    int time = 0;                          // current time in simulation
-
-    // Main loop: continue until all processes are completed
-    while (completed < n) {
-
-        int idx = -1;                      // index of selected process to run at this time unit
-        int minrt = 999999;                // holds the minimum remaining time found (initialize very large)
-
-        // Find the process with smallest remaining time which has arrived
+    ios::sync_with_stdio(false);           // faster cin/cout for large inputs
+
+    ProcessTable pt;                       // process table: pt.art = arrival time, pt.bt = burst time
+    const char *trace = argValue(argc, argv, "--trace");
+    if (trace) {                           // batch mode: every process comes from the trace file
+        if (!loadTrace(trace, pt)) return 1;
+    } else {
+        int n;                                 // number of processes
+        cout << "Enter number of processes : "; // prompt user
+        cin >> n;                              // read number of processes
+        pt.art.resize(n);
+        pt.bt.resize(n);
+
+        // Input block: read Arrival Time and Burst Time
         for (int i = 0; i < n; i++) {
-            if (art[i] <= time && rt[i] > 0) { // process has arrived and still needs CPU
-                if (rt[i] < minrt) {          // if remaining time is smaller than current minimum
-                    minrt = rt[i];            // update minimum remaining time
-                    idx = i;                  // update selected index
-                }
-            }
+            cout << "P" << i + 1 << " AT BT : "; // prompt for AT and BT of process i
+            cin >> pt.art[i] >> pt.bt[i];      // read arrival time and burst time
         }
+    }
 
-        // If no process has arrived yet or all arrived processes are finished -> CPU idle
-        if (idx == -1) {
-            time++;                          // advance time by 1 unit and retry
-            continue;
-        }
+    int n = pt.size();                     // number of processes
+    const vector<long long> &art = pt.art, &bt = pt.bt; // short names for the AT and BT columns
+    vector<long long> ct(n), tat(n), wt(n); // ct: completion time, tat: turnaround time, wt: waiting time
 
-        // Run the selected process for 1 time unit (preemptive simulation)
-        rt[idx]--;                           // decrement remaining time of selected process
-        time++;                              // advance current time by 1
+    const char *timeline = argValue(argc, argv, "--timeline"); // binary Gantt chart (sched_probe.h)
+    bool stats = argFlag(argc, argv, "--stats");              // print latency percentiles too
+    SchedProbe probe(stats || timeline ? n : 0, 1, timeline); // sees every run when enabled
+    if (!probe.ok()) return 1;
 
-        // If process finished now
-        if (rt[idx] == 0) {
-            ct[idx] = time;                  // completion time is current time
-            tat[idx] = ct[idx] - art[idx];   // turnaround time = completion - arrival
-            wt[idx] = tat[idx] - bt[idx];    // waiting time = turnaround - burst
-            completed++;                     // increment number of completed processes
-        }
+    if (stats || timeline) srtfEventDriven(art, bt, ct, probe);
+    else srtfEventDriven(art, bt, ct);     // run the simulation, fills ct[]
+
+    for (int i = 0; i < n; i++) {
+        tat[i] = ct[i] - art[i];           // turnaround time = completion - arrival
+        wt[i] = tat[i] - bt[i];            // waiting time = turnaround - burst
     }
 
     // Print table header and per-process results
     cout << "\nPID\tAT\tBT\tCT\tTAT\tWT\n";
     for (int i = 0; i < n; i++) {
-        cout << "P" << pid[i] << "\t" << art[i] << "\t" << bt[i] << "\t"
-             << ct[i] << "\t" << tat[i] << "\t" << wt[i] << endl;
+        cout << "P" << i + 1 << "\t" << art[i] << "\t" << bt[i] << "\t"
+             << ct[i] << "\t" << tat[i] << "\t" << wt[i] << "\n";
     }
 
     // Compute and display average waiting time and average turnaround time
-    float total_wt = 0, total_tat = 0;     // accumulators for totals
+    double total_wt = 0, total_tat = 0;    // accumulators for totals (double: millions of rows)
     for (int i = 0; i < n; i++) {
         total_wt += wt[i];                 // sum waiting times
         total_tat += tat[i];               // sum turnaround times
@@ -87,6 +84,10 @@ int main()
 
     cout << "\nAverage Waiting Time     : " << total_wt / n << endl;    // print average WT
     cout << "Average Turn-Around Time : " << total_tat / n << endl;    // print average TAT
+    if (stats) {                                 // latency percentiles, context switches, preemptions
+        probe.finish(art, bt, ct);
+        probe.report(cout);
+    }
 
     return 0;                              // normal program termination
 }
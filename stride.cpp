@@ -0,0 +1,178 @@
+/*
+    TOPIC: Stride Scheduling (Deterministic Proportional-Share CPU Scheduling)
+
+    WHAT IS STRIDE SCHEDULING?
+    - The deterministic cousin of lottery scheduling (lottery.cpp): every process holds
+      tickets, and over time it gets a share of the CPU proportional to its tickets.
+    - Each process has a stride = STRIDE1 / tickets (many tickets = small stride) and a pass value.
+    - Every quantum, the ready process with the smallest pass runs, then its pass grows by its
+      stride. A process with twice the tickets advances half as fast, so it runs twice as often.
+    - Unlike lottery scheduling the shares are exact over short windows, not just on average.
+
+    WHAT DOES THIS PROGRAM DO?
+    - Reads n processes with Arrival Time (AT), Burst Time (BT) and tickets (the priority
+      input of priority.cpp; here more tickets = more CPU) and the time quantum,
+      or reads them from a trace file: stride --trace FILE --tq Q
+      (the trace's PR column holds the tickets, see proc_trace.h).
+    - A new process joins with pass = global pass + its stride, where the global pass is the
+      pass of the process scheduled last, so it gets its share from now on without
+      catching up on the time before it arrived.
+    - Prints Completion Time (CT), Turn-Around Time (TAT) and Waiting Time (WT) per process,
+      and the averages.
+    - --stats also prints waiting, turn-around and response time percentiles, context switches
+      and preemptions; --timeline FILE saves the Gantt chart (see sched_probe.h).
+    - There is no randomness: ties go to the lower index, so every run gives the same schedule.
+
+    HOW IS IT FAST?
+    - Ready processes sit in a min-heap of (pass, index): each quantum is O(log n).
+    - When only one process is ready, it runs until the quantum in which the next process
+      arrives (or until it finishes) in one step, and the pass values are renumbered from 0
+      so they cannot overflow during long runs.
+*/
+
+#include <iostream>     // For cin, cout, cerr
+#include <vector>       // For vector (process table of any size)
+#include <queue>        // For priority_queue (pass-value min-heap)
+#include <algorithm>    // For stable_sort, min, max
+#include <numeric>      // For iota
+#include <functional>   // For greater
+#include <climits>      // For LLONG_MAX
+#include <cstdlib>      // For atoll
+#include "proc_trace.h" // For ProcessTable, loadTrace(), argValue()
+#include "sched_probe.h" // For SchedProbe (--stats, --timeline)
+using namespace std;    // Avoid writing std:: repeatedly
+
+const long long STRIDE1 = 1 << 20;          // stride of a process holding a single ticket
+
+// Stride scheduling: fills ct[] given arrival times, burst times, tickets and the quantum
+template <class Probe = NullProbe>
+void strideScheduling(const vector<long long> &art, const vector<long long> &bt,
+                      const vector<long long> &tickets, long long tq, vector<long long> &ct,
+                      Probe &&probe = Probe())
+{
+    int n = art.size();                     // number of processes
+
+    vector<int> order(n);                   // process indices sorted by arrival time
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](int a, int b) { return art[a] < art[b]; });
+
+    vector<long long> stride(n), pass(n), rem(bt);
+    for (int i = 0; i < n; i++) stride[i] = max(1LL, STRIDE1 / tickets[i]);
+
+    typedef pair<long long, int> Entry;                      // (pass, process index)
+    priority_queue<Entry, vector<Entry>, greater<Entry>> ready; // min-heap on pass
+
+    long long time = 0;                     // current time
+    long long globalPass = 0;               // pass of the process scheduled last
+    int next = 0;                           // position in order[] of the next process to arrive
+
+    for (int done = 0; done < n; ) {
+        if (ready.empty())                  // CPU idle: jump to the next arrival
+            time = max(time, art[order[next]]);
+        while (next < n && art[order[next]] <= time) {
+            int i = order[next++];          // admit every process that has arrived by now
+            pass[i] = globalPass + stride[i];
+            ready.push(Entry(pass[i], i));
+        }
+
+        int w = ready.top().second;         // smallest pass runs next
+        ready.pop();
+        long long quanta = 1;               // quanta it runs before the next decision
+        if (ready.empty())                  // alone: run until the quantum of the next arrival
+            quanta = next < n ? max(1LL, (art[order[next]] - time + tq - 1) / tq) : LLONG_MAX / tq;
+        long long slice = min(rem[w], quanta * tq);
+
+        probe.run(0, w, time, time + slice, rem[w] == slice);
+        time += slice;
+        rem[w] -= slice;
+        if (ready.empty()) {                // alone: only relative passes matter, start again from 0
+            globalPass = 0;
+            pass[w] = stride[w];
+        } else {
+            globalPass = pass[w];
+            pass[w] += stride[w];
+        }
+
+        if (rem[w] == 0) {                  // finished: record completion time
+            ct[w] = time;
+            done++;
+        } else {
+            ready.push(Entry(pass[w], w));  // back into the heap with its new pass
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    ios::sync_with_stdio(false);            // faster cin/cout for large inputs
+
+    long long tq;                           // time quantum
+    ProcessTable pt;                        // process table: pt.art, pt.bt, pt.pr (= tickets) columns
+    const char *trace = argValue(argc, argv, "--trace");
+    if (trace) {                            // batch mode: every process comes from the trace file
+        const char *q = argValue(argc, argv, "--tq");
+        if (!q || atoll(q) <= 0) {
+            cerr << "usage: stride --trace FILE --tq QUANTUM [--stats] [--timeline FILE]\n";
+            return 1;
+        }
+        tq = atoll(q);
+        if (!loadTrace(trace, pt)) return 1;
+        if (!pt.hasPriority()) {
+            cerr << trace << ": trace has no priority (tickets) column\n";
+            return 1;
+        }
+    } else {
+        int n;                              // number of processes
+        cout << "Enter number of processes : ";
+        cin >> n;
+        pt.art.resize(n);
+        pt.bt.resize(n);
+        pt.pr.resize(n);
+
+        cout << "Enter Time Quantum : ";
+        cin >> tq;
+
+        for (int i = 0; i < n; i++) {       // arrival time, burst time and tickets of each process
+            cout << "P" << i + 1 << " AT BT Tickets : ";
+            cin >> pt.art[i] >> pt.bt[i] >> pt.pr[i];
+        }
+        if (tq <= 0) { cerr << "time quantum must be positive\n"; return 1; }
+    }
+
+    int n = pt.size();                      // number of processes
+    const vector<long long> &art = pt.art, &bt = pt.bt, &tickets = pt.pr; // short column names
+    for (int i = 0; i < n; i++)
+        if (tickets[i] <= 0) {
+            cerr << "P" << i + 1 << ": ticket count must be positive\n";
+            return 1;
+        }
+
+    vector<long long> ct(n), tat(n), wt(n); // completion, turn-around and waiting times
+    const char *timeline = argValue(argc, argv, "--timeline"); // binary Gantt chart (sched_probe.h)
+    bool stats = argFlag(argc, argv, "--stats");              // print latency percentiles too
+    SchedProbe probe(stats || timeline ? n : 0, 1, timeline); // sees every run when enabled
+    if (!probe.ok()) return 1;
+
+    if (stats || timeline) strideScheduling(art, bt, tickets, tq, ct, probe);
+    else strideScheduling(art, bt, tickets, tq, ct); // run the simulation, fills ct[]
+
+    double total_wt = 0, total_tat = 0;     // totals for averages
+    cout << "\nPID\tAT\tBT\tTICKETS\tCT\tTAT\tWT\n";
+    for (int i = 0; i < n; i++) {
+        tat[i] = ct[i] - art[i];            // TAT = CT - AT
+        wt[i] = tat[i] - bt[i];             // WT = TAT - BT
+        total_wt += wt[i];
+        total_tat += tat[i];
+        cout << "P" << i + 1 << "\t" << art[i] << "\t" << bt[i] << "\t" << tickets[i] << "\t"
+             << ct[i] << "\t" << tat[i] << "\t" << wt[i] << "\n";
+    }
+
+    cout << "\nAverage Waiting Time     : " << total_wt / n << endl;
+    cout << "Average Turn-Around Time : " << total_tat / n << endl;
+    if (stats) {                            // latency percentiles, context switches, preemptions
+        probe.finish(art, bt, ct);
+        probe.report(cout);
+    }
+
+    return 0;                               // successful termination
+}
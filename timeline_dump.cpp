@@ -0,0 +1,84 @@
+/*
+    TOPIC: Gantt Timeline Dump - print a binary scheduling timeline as text
+
+    WHAT IS A TIMELINE FILE?
+    - The scheduling programs (fcfs, sjf, srtf, rrobin, smp_sched, ...) write one with
+      --timeline FILE: every stretch of time a process ran on a CPU, i.e. the Gantt chart.
+    - It is binary and run-length encoded to stay small on million-process runs
+      (format: see sched_probe.h).
+
+    WHAT DOES THIS PROGRAM DO?
+    - Decodes the file and prints one line per run:   CPU  PID  START  END
+      in the order they were recorded (per CPU, in time order).
+    - With --summary it prints only the number of runs and the busy time of each CPU.
+
+    USAGE
+        timeline_dump FILE [--summary]
+*/
+
+#include <iostream>         // For cout, cerr
+#include <vector>           // For vector (per-CPU state)
+#include <cstdint>          // For uint32_t, uint64_t
+#include <cstring>          // For memcmp, memcpy
+#include "proc_trace.h"     // For MappedFile, argFlag()
+using namespace std;        // Avoid writing std:: repeatedly
+
+// Read one LEB128 varint at p (advancing it); false if the file ends in the middle
+bool readVarint(const char *&p, const char *end, uint64_t &v)
+{
+    v = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        unsigned char b = *p++;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+int main(int argc, char *argv[])
+{
+    ios::sync_with_stdio(false);            // faster cout for large outputs
+
+    if (argc < 2 || argv[1][0] == '-') {
+        cerr << "usage: timeline_dump FILE [--summary]\n";
+        return 1;
+    }
+    bool summary = argFlag(argc, argv, "--summary");
+
+    MappedFile file(argv[1]);
+    if (!file.ok) { cerr << argv[1] << ": cannot open timeline file\n"; return 1; }
+    const char *p = file.data, *end = file.data + file.size;
+    uint32_t cpus;
+    if (file.size < 8 || memcmp(p, "GNT1", 4) != 0) {
+        cerr << argv[1] << ": not a timeline file\n";
+        return 1;
+    }
+    memcpy(&cpus, p + 4, sizeof cpus);
+    p += 8;
+
+    vector<long long> last(cpus, 0);        // end of the previous run on each CPU
+    vector<long long> busy(cpus, 0);        // total running time of each CPU
+    long long runs = 0;
+    if (!summary) cout << "CPU\tPID\tSTART\tEND\n";
+    while (p < end) {
+        uint64_t cpu, pid, gap, len;
+        if (!readVarint(p, end, cpu) || !readVarint(p, end, pid) ||
+            !readVarint(p, end, gap) || !readVarint(p, end, len) || cpu >= cpus) {
+            cerr << argv[1] << ": corrupt record after " << runs << " runs\n";
+            return 1;
+        }
+        long long g = (gap & 1) ? -(long long)((gap + 1) >> 1) : (long long)(gap >> 1); // undo zigzag
+        long long start = last[cpu] + g, stop = start + (long long)len;
+        last[cpu] = stop;
+        busy[cpu] += len;
+        runs++;
+        if (!summary) cout << cpu << "\tP" << pid + 1 << "\t" << start << "\t" << stop << "\n";
+    }
+
+    if (summary) {
+        cout << "CPU\tBusy\n";
+        for (uint32_t c = 0; c < cpus; c++) cout << c << "\t" << busy[c] << "\n";
+        cout << "\nRuns                     : " << runs << "\n";
+    }
+    return 0;                               // successful termination
+}
@@ -0,0 +1,160 @@
+/*
+    TOPIC: Address Translation - TLB and multi-level page table walks
+
+    WHAT IS THIS FILE?
+    - Before a page can be looked up in memory its virtual page number must be translated.
+      The TLB caches recent translations; on a TLB miss the hardware walks the page table,
+      one memory access per level, and only then does the page replacement policy's view of
+      memory (hit or page fault) matter. page_replace --tlb puts this model in front of every
+      policy and reports the translation cost next to the faults.
+
+    THE MODEL
+    - TLB: --tlb-entries E (default 64) in sets of --tlb-ways W (default 4; W = E is fully
+      associative), the set picked by the low bits of the page number. --tlb-repl lru
+      (default) or random picks the victim in a full set.
+    - Page table: an x86-64 style radix tree over 48-bit virtual addresses, 9 bits per level.
+      4K pages need 4 levels (PML4, PDPT, PD, PT); huge pages end the walk early: 2M pages
+      take 3 levels, 1G pages 2. The page size is the trace's --page-size.
+    - Paging-structure caches: --pwc N (default 0 = none) keeps the N most recent entries of
+      every level above the last, so a walk starts below the deepest level it finds cached
+      (like Intel's PML4E/PDPTE/PDE caches).
+    - A faulting reference always counts as a TLB miss and a walk: the page was not resident,
+      so no valid translation for it can be cached. Evictions are not modelled as shootdowns,
+      though (the policies do not report their victims): the entry of an evicted page stays
+      in its set, taking a way, until replacement pushes it out or the page faults back in.
+    - Effective access time per reference = TLB lookup + walk accesses * memory time +
+      the access itself + (on a fault) the fault service time: --tlb-ns (1), --mem-ns (100)
+      and --fault-ns (8000000, a disk).
+
+    HOW IS IT FAST?
+    - Each set is W consecutive tags compared in one pass (with SIMD, scanFrames(), when W is
+      a multiple of 16) and LRU keeps a use stamp per entry, so a lookup costs a few compares
+      and no allocation; walks only happen on misses.
+*/
+
+#ifndef TLB_H
+#define TLB_H
+
+#include <vector>          // std::vector
+#include <cstring>         // std::strcmp
+#include <cstdlib>         // std::atoi, std::atof
+#include <iostream>        // std::cerr
+#include "proc_trace.h"    // argValue(), argFlag()
+#include "page_policies.h" // scanFrames(), NO_PAGE
+
+struct TlbSpec {
+    int entries = 64, ways = 4;            // TLB size and associativity
+    bool random = false;                   // random replacement instead of LRU
+    int walkCache = 0;                     // paging-structure cache entries per upper level
+    int pageShift = 12;                    // page size = 2^pageShift bytes
+    double tlbNs = 1, memNs = 100, faultNs = 8e6;  // latencies for the effective access time
+};
+
+// A set-associative cache of page numbers (the TLB, and the paging-structure caches)
+class SetAssocCache {
+public:
+    SetAssocCache(int entries, int ways, bool random)
+        : ways(ways), setMask(entries / ways - 1), random(random),
+          tag(entries, NO_PAGE), stamp(entries, 0) {}
+
+    bool access(long long key) {           // true on a hit; on a miss key replaces a victim
+        long long *set = &tag[(key & setMask) * ways];
+        int w = ways % 16 == 0 ? scanFrames(set, ways, key) : scanFramesScalar(set, ways, key);
+        if (w >= 0) {
+            stamp[set - tag.data() + w] = ++clock;
+            return true;
+        }
+        unsigned long long *use = &stamp[set - tag.data()];
+        int victim = 0;
+        if (random) {                      // an empty way if there is one, else any way
+            victim = scanFramesScalar(set, ways, NO_PAGE);
+            if (victim < 0) {
+                seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17; // xorshift64
+                victim = seed % ways;
+            }
+        } else {                           // least recently used (empty ways have stamp 0)
+            for (int i = 1; i < ways; i++)
+                if (use[i] < use[victim]) victim = i;
+        }
+        set[victim] = key;
+        use[victim] = ++clock;
+        return false;
+    }
+
+private:
+    int ways;
+    long long setMask;                     // sets - 1 (sets is a power of two)
+    bool random;
+    std::vector<long long> tag;            // set s is tag[s * ways .. s * ways + ways)
+    std::vector<unsigned long long> stamp; // LRU: time of the latest use, 0 = never
+    unsigned long long clock = 0, seed = 0x9E3779B97F4A7C15ULL;
+};
+
+// TLB + page walk for every reference, with the counts behind the report
+class AddressTranslation {
+public:
+    explicit AddressTranslation(const TlbSpec &spec)
+        : spec(spec), levels((48 - spec.pageShift + 8) / 9), tlb(spec.entries, spec.ways, spec.random) {
+        if (levels < 1) levels = 1;
+        if (spec.walkCache > 0)
+            for (int l = 1; l < levels; l++) pwc.emplace_back(spec.walkCache, spec.walkCache, false);
+    }
+
+    void translate(long long page, bool fault) {
+        refs++;
+        faults += fault;
+        if (tlb.access(page) && !fault) { hits++; return; }
+        // Walk: pwc[l] caches the entries of level l (0 = top), tagged by the address bits
+        // that select them. The deepest hit saves the reads down to it; the misses on the
+        // way are loaded for the next walk.
+        int start = 0;
+        for (int l = (int)pwc.size() - 1; l >= 0; l--)
+            if (pwc[l].access(page >> (9 * (levels - 1 - l)))) { start = l + 1; break; }
+        walkAccesses += levels - start;
+    }
+
+    long long references() const { return refs; }
+    long long tlbHits() const { return hits; }
+    long long walkMemoryAccesses() const { return walkAccesses; }
+    int walkLevels() const { return levels; }
+
+    double effectiveAccessNs() const {     // mean time per reference
+        if (refs == 0) return 0;
+        return spec.tlbNs + spec.memNs + (walkAccesses * spec.memNs + faults * spec.faultNs) / refs;
+    }
+
+private:
+    TlbSpec spec;
+    int levels;                            // page table levels above the page
+    SetAssocCache tlb;
+    std::vector<SetAssocCache> pwc;        // paging-structure caches, top level first
+    long long refs = 0, hits = 0, faults = 0, walkAccesses = 0;
+};
+
+// Read the TLB options (see the top of this file) from the command line; false on errors
+inline bool parseTlb(int argc, char *argv[], TlbSpec &spec)
+{
+    if (const char *s = argValue(argc, argv, "--tlb-entries")) spec.entries = std::atoi(s);
+    if (const char *s = argValue(argc, argv, "--tlb-ways")) spec.ways = std::atoi(s);
+    if (const char *s = argValue(argc, argv, "--pwc")) spec.walkCache = std::atoi(s);
+    if (const char *s = argValue(argc, argv, "--tlb-ns")) spec.tlbNs = std::atof(s);
+    if (const char *s = argValue(argc, argv, "--mem-ns")) spec.memNs = std::atof(s);
+    if (const char *s = argValue(argc, argv, "--fault-ns")) spec.faultNs = std::atof(s);
+    if (const char *s = argValue(argc, argv, "--tlb-repl")) {
+        if (std::strcmp(s, "lru") == 0) spec.random = false;
+        else if (std::strcmp(s, "random") == 0) spec.random = true;
+        else { std::cerr << "--tlb-repl: expected lru or random\n"; return false; }
+    }
+    int sets = spec.ways > 0 ? spec.entries / spec.ways : 0;
+    if (spec.ways <= 0 || sets <= 0 || sets * spec.ways != spec.entries || (sets & (sets - 1))) {
+        std::cerr << "--tlb-entries, --tlb-ways: the entries must be a power-of-two number of sets of ways\n";
+        return false;
+    }
+    if (spec.walkCache < 0 || !(spec.tlbNs >= 0 && spec.memNs >= 0 && spec.faultNs >= 0)) {
+        std::cerr << "--pwc, --tlb-ns, --mem-ns, --fault-ns: expected non-negative numbers\n";
+        return false;
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,32 @@
+/*
+    TOPIC: Process Trace Converter (text -> binary)
+
+    WHAT IS THIS PROGRAM?
+    - The CPU scheduling programs accept "--trace FILE" with either a text (CSV) trace or a
+      binary trace (formats described in proc_trace.h).
+    - Text is easy to write by hand; binary loads much faster for millions of processes.
+
+    WHAT DOES THIS PROGRAM DO?
+    - Loads any trace (text or binary) and writes it out in the binary format.
+    - Usage: trace_convert INPUT OUTPUT
+*/
+
+#include <iostream>         // For cout, cerr
+#include "proc_trace.h"     // For ProcessTable, loadTrace(), saveBinaryTrace()
+using namespace std;        // Avoid writing std:: repeatedly
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3) {                                  // Need exactly an input and an output path
+        cerr << "usage: trace_convert INPUT OUTPUT\n";
+        return 1;
+    }
+
+    ProcessTable pt;                                  // The whole trace, one array per column
+    if (!loadTrace(argv[1], pt)) return 1;            // Read the input trace
+    if (!saveBinaryTrace(argv[2], pt)) return 1;      // Write it back as binary
+
+    cout << "Wrote " << pt.size() << " processes ("
+         << (pt.hasPriority() ? "AT,BT,PR" : "AT,BT") << ") to " << argv[2] << endl;
+    return 0;                                         // Success
+}
@@ -0,0 +1,119 @@
+/*
+    TOPIC: Working Sets and Page Fault Frequency - variable memory allocation
+
+    WHAT IS A WORKING SET?
+    - Denning's working set W(t, D) is the set of distinct pages a process referenced in its
+      last D references (the window). A process runs well when its working set is resident,
+      so |W(t, D)| over time says how much memory it actually needs, and when.
+    - The working-set policy keeps exactly W(t, D) resident: a reference faults when its page
+      was not used in the previous D references. Larger windows mean fewer faults but more
+      memory; the faults and the mean size for several windows show the trade-off.
+
+    WHAT IS PAGE FAULT FREQUENCY (PFF)?
+    - PFF (Chu & Opderbeck) sizes the resident set from the fault rate instead of a window.
+      On a fault that comes soon after the previous one (within T references) the process is
+      short of memory, and the new page is simply added. On a fault after a quiet stretch
+      (more than T references) the pages not referenced since the previous fault are released
+      first. The resident set grows and shrinks with the program's phases.
+
+    WHAT IS IN THIS FILE?
+    - WorkingSet: |W(t, D)| and the working-set policy's faults for any number of windows,
+      updated in one pass.
+    - PffPolicy: PFF as a policy in the style of page_policies.h (access(page) returns true
+      on a fault), plus resident(), the current resident set size.
+
+    HOW IS IT FAST?
+    - WorkingSet never rescans a window. A ring buffer remembers the last max(D) references
+      and whether each is still the latest reference to its page. When a reference becomes
+      D old it leaves W(t, D) exactly when it is still the latest one; a new reference enters
+      when the page's previous reference (from a last-access hash index) is more than D back.
+      That is O(1) per reference and window, in memory proportional to the largest window.
+    - PffPolicy keeps the resident pages in recency order, so the pages not referenced since
+      the last fault are exactly a run at the back of the list: releasing them costs O(1)
+      per page released.
+*/
+
+#ifndef WORKING_SET_H
+#define WORKING_SET_H
+
+#include <vector>          // std::vector
+#include <algorithm>       // std::max_element
+#include "page_policies.h" // PageIndex, PageLists, PagePolicy
+
+class WorkingSet {
+public:
+    explicit WorkingSet(const std::vector<long long> &windows)  // every window >= 1
+        : window(windows), wss(windows.size()), fault(windows.size()) {
+        long long widest = *std::max_element(windows.begin(), windows.end());
+        ringPage.resize(widest + 1);
+        latest.resize(widest + 1);
+        last.reset(widest + 1);
+    }
+
+    void access(long long page) {
+        long long ring = ringPage.size();  // = widest window + 1
+        long long prev = last.find(page);  // previous reference, -1 if older than every window
+        if (prev != -1) latest[prev % ring] = 0;
+        ringPage[now % ring] = page;
+        latest[now % ring] = 1;
+
+        for (size_t k = 0; k < window.size(); k++) {
+            long long d = window[k];
+            if (prev == -1 || prev < now - d) { wss[k]++; fault[k]++; }  // enters W(t, d)
+            if (now - d >= 0 && latest[(now - d) % ring]) wss[k]--;     // leaves it
+        }
+
+        // A page whose latest reference is older than the widest window is forgotten
+        long long old = now - (ring - 1);
+        if (old >= 0 && latest[old % ring]) last.erase(ringPage[old % ring]);
+        last.set(page, now);
+        now++;
+    }
+
+    long long size(int k) const { return wss[k]; }      // |W(t, window k)|
+    long long faults(int k) const { return fault[k]; }  // working-set policy faults so far
+    long long references() const { return now; }
+
+private:
+    std::vector<long long> window;         // the window sizes D
+    std::vector<long long> wss, fault;     // per window: working set size, faults
+    std::vector<long long> ringPage;       // page of each of the last max(D)+1 references
+    std::vector<char> latest;              // ... and whether it is still its page's latest
+    PageIndex<long long> last;             // page -> time of its latest reference (in the ring)
+    long long now = 0;                     // references so far
+};
+
+class PffPolicy : public PagePolicy<PffPolicy> {
+public:
+    static constexpr const char *NAME = "PFF";
+
+    explicit PffPolicy(long long threshold) : threshold(threshold), pages(1, 1024) {}
+
+    bool reference(long long page) {
+        now++;
+        int node = pages.find(page);
+        if (node != -1) {
+            pages.moveToFront(node, 0);
+            lastRef[node] = now;
+            return false;
+        }
+        if (now - lastFault > threshold)   // quiet since the last fault: release unused pages
+            while (pages.size(0) > 0 && lastRef[pages.back(0)] < lastFault) pages.popBack(0);
+        lastFault = now;
+        node = pages.pushFront(page, 0);
+        if (node >= (int)lastRef.size()) lastRef.resize(node + 1);
+        lastRef[node] = now;
+        return true;
+    }
+
+    int resident() const { return pages.size(0); }    // resident set size
+    long long references() const { return now; }
+
+private:
+    long long threshold;                   // T: longest fault interval that still grows the set
+    PageLists pages;                       // resident pages, most recently used first
+    std::vector<long long> lastRef;        // time of the latest reference, by node
+    long long now = 0, lastFault = 0;      // references so far, time of the last fault
+};
+
+#endif
@@ -0,0 +1,186 @@
+/*
+    TOPIC: Synthetic Workloads - seeded process traces of any size
+
+    WHAT IS THIS FILE?
+    - Real traces are rarely at hand in the size needed to test a scheduler, so this file
+      generates a ProcessTable (see proc_trace.h) from a few statistical knobs.
+    - workload_gen.cpp writes the result as a trace file; sched_bench.cpp generates workloads
+      in memory to time the engines.
+
+    ARRIVAL PROCESSES (--arrival, mean --rate processes per time unit)
+    - poisson : independent arrivals, exponential gaps between them.
+    - bursty  : batch Poisson: batches arrive as a Poisson process and every process in a batch
+                arrives at the same moment; batch sizes are geometric with mean --batch.
+    - diurnal : Poisson whose rate follows a daily cycle,
+                rate(t) = rate * (1 + amplitude * sin(2 pi t / period)),
+                drawn by thinning (draw at the peak rate, keep each arrival with rate(t) / peak).
+
+    BURST DISTRIBUTIONS (--burst, mean --mean)
+    - exp     : exponential, the classic memoryless CPU burst.
+    - pareto  : heavy-tailed Pareto with shape --alpha (> 1); most jobs are short, a few are
+                huge. The scale is chosen so the mean is --mean.
+    - bimodal : a share --long-share of long jobs (--long-ratio times longer than the short
+                ones), the rest short; both exponential, overall mean --mean.
+      Bursts are rounded to whole time units (at least 1); arrival times are truncated.
+
+    PRIORITY MIX (--prio W1,W2,...,WK)
+    - Each process gets priority 1..K with probability proportional to the weights,
+      e.g. 1,3,6 = 10% priority 1, 30% priority 2, 60% priority 3. Without --prio the
+      workload has no PR column. Values start at 1 so they also work as tickets (lottery,
+      stride) and as nice levels (cfs).
+
+    REPRODUCIBLE
+    - Everything comes from std::mt19937_64 seeded with --seed, turned into uniform doubles
+      by bit arithmetic rather than std:: distributions (whose algorithms differ between
+      standard libraries), so the same seed gives the same trace with every compiler.
+*/
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <vector>       // std::vector
+#include <random>       // std::mt19937_64
+#include <cmath>        // std::log, std::pow, std::sin, std::llround
+#include <cstring>      // std::strcmp
+#include <cstdlib>      // std::strtod, std::strtoull
+#include <iostream>     // std::cerr
+#include "proc_trace.h" // ProcessTable, argValue()
+
+enum ArrivalKind { ARRIVAL_POISSON, ARRIVAL_BURSTY, ARRIVAL_DIURNAL };
+enum BurstKind { BURST_EXP, BURST_PARETO, BURST_BIMODAL };
+
+struct WorkloadSpec {
+    unsigned long long seed = 1;           // random seed
+    ArrivalKind arrival = ARRIVAL_POISSON;
+    double rate = 0.09;                    // mean arrivals per time unit (load 0.9 at mean 10)
+    double batch = 8;                      // bursty: mean batch size
+    double period = 86400;                 // diurnal: length of one cycle
+    double amplitude = 0.8;                // diurnal: relative swing of the rate (0 .. 1)
+    BurstKind burst = BURST_EXP;
+    double mean = 10;                      // mean burst time
+    double alpha = 1.5;                    // pareto: shape (tail index)
+    double longShare = 0.1;                // bimodal: share of long jobs
+    double longRatio = 20;                 // bimodal: long mean / short mean
+    std::vector<double> prio;              // priority weights (empty = no PR column)
+};
+
+// Random numbers drawn the same way on every platform
+class WorkloadRng {
+public:
+    WorkloadRng(unsigned long long seed) : rng(seed) {}
+    double uniform() { return (rng() >> 11) * 0x1.0p-53; }            // [0, 1)
+    double exponential(double mean) { return -mean * std::log(1 - uniform()); }
+private:
+    std::mt19937_64 rng;
+};
+
+// Fill t with n processes drawn from spec
+inline void generateWorkload(const WorkloadSpec &spec, long long n, ProcessTable &t)
+{
+    WorkloadRng rng(spec.seed);
+    t.art.resize(n);
+    t.bt.resize(n);
+    t.pr.clear();
+
+    // Arrivals: non-decreasing times, so the table is already in arrival order
+    const double PI = 3.14159265358979323846;
+    double now = 0;
+    long long left = 0;                    // bursty: processes still to come in this batch
+    for (long long i = 0; i < n; i++) {
+        if (spec.arrival == ARRIVAL_POISSON) {
+            now += rng.exponential(1 / spec.rate);
+        } else if (spec.arrival == ARRIVAL_BURSTY) {
+            if (left == 0) {               // next batch: Poisson batch times, geometric sizes
+                now += rng.exponential(spec.batch / spec.rate);
+                left = 1;
+                while (rng.uniform() >= 1 / spec.batch) left++;
+            }
+            left--;
+        } else {                           // diurnal: thinning against the peak rate
+            double peak = spec.rate * (1 + spec.amplitude);
+            do now += rng.exponential(1 / peak);
+            while (rng.uniform() * peak > spec.rate * (1 + spec.amplitude * std::sin(2 * PI * now / spec.period)));
+        }
+        t.art[i] = (long long)now;
+    }
+
+    // Bursts
+    double xm = spec.mean * (spec.alpha - 1) / spec.alpha;  // pareto scale giving that mean
+    double shortMean = spec.mean / (1 - spec.longShare + spec.longShare * spec.longRatio);
+    for (long long i = 0; i < n; i++) {
+        double b;
+        if (spec.burst == BURST_EXP) b = rng.exponential(spec.mean);
+        else if (spec.burst == BURST_PARETO) b = xm / std::pow(1 - rng.uniform(), 1 / spec.alpha);
+        else if (rng.uniform() < spec.longShare) b = rng.exponential(shortMean * spec.longRatio);
+        else b = rng.exponential(shortMean);
+        t.bt[i] = b < 1.5 ? 1 : b > 4e18 ? (long long)4e18 : std::llround(b);
+    }
+
+    // Priorities: inverse of the cumulative weights
+    if (spec.prio.empty()) return;
+    std::vector<double> cum(spec.prio.size());
+    double sum = 0;
+    for (size_t k = 0; k < cum.size(); k++) cum[k] = sum += spec.prio[k];
+    t.pr.resize(n);
+    for (long long i = 0; i < n; i++) {
+        double u = rng.uniform() * sum;
+        size_t k = 0;
+        while (k + 1 < cum.size() && u >= cum[k]) k++;
+        t.pr[i] = k + 1;
+    }
+}
+
+// Read the workload options (see the top of this file) from the command line; false on errors
+inline bool parseWorkload(int argc, char *argv[], WorkloadSpec &spec)
+{
+    auto number = [&](const char *name, double &v, double lo, double hi) {
+        const char *s = argValue(argc, argv, name);
+        if (!s) return true;
+        char *end;
+        v = std::strtod(s, &end);
+        if (end == s || *end || !(v >= lo && v <= hi)) {
+            std::cerr << name << ": expected a number from " << lo << " to " << hi << "\n";
+            return false;
+        }
+        return true;
+    };
+
+    if (const char *s = argValue(argc, argv, "--seed")) spec.seed = std::strtoull(s, nullptr, 10);
+    if (const char *s = argValue(argc, argv, "--arrival")) {
+        if (std::strcmp(s, "poisson") == 0) spec.arrival = ARRIVAL_POISSON;
+        else if (std::strcmp(s, "bursty") == 0) spec.arrival = ARRIVAL_BURSTY;
+        else if (std::strcmp(s, "diurnal") == 0) spec.arrival = ARRIVAL_DIURNAL;
+        else { std::cerr << "--arrival: expected poisson, bursty or diurnal\n"; return false; }
+    }
+    if (const char *s = argValue(argc, argv, "--burst")) {
+        if (std::strcmp(s, "exp") == 0) spec.burst = BURST_EXP;
+        else if (std::strcmp(s, "pareto") == 0) spec.burst = BURST_PARETO;
+        else if (std::strcmp(s, "bimodal") == 0) spec.burst = BURST_BIMODAL;
+        else { std::cerr << "--burst: expected exp, pareto or bimodal\n"; return false; }
+    }
+    if (!number("--rate", spec.rate, 1e-12, 1e12) || !number("--batch", spec.batch, 1, 1e12) ||
+        !number("--period", spec.period, 1, 1e18) || !number("--amplitude", spec.amplitude, 0, 1) ||
+        !number("--mean", spec.mean, 1, 1e15) || !number("--alpha", spec.alpha, 1.0001, 100) ||
+        !number("--long-share", spec.longShare, 0, 1) || !number("--long-ratio", spec.longRatio, 1, 1e9))
+        return false;
+
+    if (const char *s = argValue(argc, argv, "--prio")) {
+        spec.prio.clear();
+        while (*s) {
+            char *end;
+            double w = std::strtod(s, &end);
+            if (end == s || w < 0 || (*end && *end != ',')) { spec.prio.clear(); break; }
+            spec.prio.push_back(w);
+            s = *end ? end + 1 : end;
+        }
+        double sum = 0;
+        for (double w : spec.prio) sum += w;
+        if (spec.prio.empty() || sum <= 0) {
+            std::cerr << "--prio: expected weights W1,W2,... (not all zero)\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif